@@ -0,0 +1,762 @@
+/**
+ * @file    Benchmark.cpp
+ * @ingroup HtmlBuilder
+ * @brief   Benchmarks of the construction and serialization of typical HTML Documents, using Google Benchmark.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <HTML/HTML.h>
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+using namespace HTML::literals; // NOLINT(build/namespaces) names of the attributes without copy
+
+// Count all heap allocations of the process, to report the number of allocations per node
+// Note: atomic since the pages are also built and serialized concurrently, see BM_ConcurrentPages
+static std::atomic<size_t> sAllocations(0);
+
+#if defined(__GNUC__) && !defined(__clang__) && (__GNUC__ >= 11)
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete" // false positive on the replacement of operator new/delete
+#endif
+
+void* operator new(size_t aSize) {
+    sAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pMemory = std::malloc(aSize ? aSize : 1)) {
+        return pMemory;
+    }
+    throw std::bad_alloc();
+}
+void operator delete(void* apMemory) noexcept {
+    std::free(apMemory);
+}
+void operator delete(void* apMemory, size_t) noexcept {
+    std::free(apMemory);
+}
+
+/// Stream buffer discarding everything, to measure operator<< without the cost of a real stream
+class NullBuffer : public std::streambuf {
+protected:
+    std::streamsize xsputn(const char*, std::streamsize aCount) override {
+        return aCount;
+    }
+    int_type overflow(int_type aChar) override {
+        return aChar;
+    }
+};
+
+/// Sink discarding everything, to measure the serialization without the cost of a real socket
+class NullSink : public HTML::Sink {
+public:
+    void write(const char* apData, size_t aSize) override {
+        benchmark::DoNotOptimize(apData);
+        mSize += aSize;
+    }
+    void writev(const HTML::IoSlice* apSlices, size_t aCount) override {
+        for (size_t idx = 0; idx < aCount; ++idx) {
+            mSize += apSlices[idx].iov_len;
+        }
+    }
+
+    size_t mSize = 0;
+};
+
+/// Number of Elements of a generated page, that is the number of opening tags (text nodes are not counted)
+static size_t countNodes(const std::string& aHtml) {
+    size_t nodes = 0;
+    for (size_t pos = aHtml.find('<'); pos != std::string::npos; pos = aHtml.find('<', pos + 1)) {
+        if ((pos + 1 < aHtml.size()) && (aHtml[pos + 1] != '/') && (aHtml[pos + 1] != '!')) {
+            ++nodes;
+        }
+    }
+    return nodes;
+}
+
+/// Wide table of 1000 rows by 20 columns
+static void buildTable(HTML::Document& aDocument) {
+    HTML::Table table;
+    table.cls("table table-hover table-sm");
+    table << (HTML::Row() << HTML::ColHeader("Id") << HTML::ColHeader("Name") << HTML::ColHeader("Value"));
+    for (unsigned int row = 0; row < 1000; ++row) {
+        HTML::Row line;
+        for (unsigned int col = 0; col < 20; ++col) {
+            line << HTML::Col("Cell_" + std::to_string(row) + "_" + std::to_string(col));
+        }
+        table << std::move(line);
+    }
+    aDocument << std::move(table);
+}
+
+/// Same wide table, stored by column in a DataTable
+static void buildDataTable(HTML::Document& aDocument) {
+    HTML::DataTable table;
+    table.cls("table table-hover table-sm");
+    for (unsigned int col = 0; col < 20; ++col) {
+        std::vector<std::string> values;
+        values.reserve(1000);
+        for (unsigned int row = 0; row < 1000; ++row) {
+            values.push_back("Cell_" + std::to_string(row) + "_" + std::to_string(col));
+        }
+        table.addColumn(col < 3 ? std::string(col == 0 ? "Id" : col == 1 ? "Name" : "Value") : std::string(),
+                        std::move(values));
+    }
+    aDocument << std::move(table);
+}
+
+/// Long table of 10000 rows by 3 columns
+static void buildLongTable(HTML::Document& aDocument) {
+    HTML::Table table;
+    table.cls("table table-sm");
+    table << (HTML::Row() << HTML::ColHeader("Id") << HTML::ColHeader("Name") << HTML::ColHeader("Link"));
+    for (unsigned int row = 0; row < 10000; ++row) {
+        HTML::Row line;
+        line.cls(row % 2 ? "odd" : "even");
+        line << HTML::Col(std::to_string(row)) << HTML::Col("Name " + std::to_string(row))
+            << (HTML::Col() << HTML::Link("Details", "/details/" + std::to_string(row)).cls("link"));
+        table << std::move(line);
+    }
+    aDocument << std::move(table);
+}
+
+/// Numeric table of 10000 rows: an integer, a price with 2 decimals and a ratio in its shortest form
+static void buildNumbers(HTML::Document& aDocument) {
+    HTML::Table table;
+    table.cls("table table-sm");
+    table << (HTML::Row() << HTML::ColHeader("Id") << HTML::ColHeader("Price") << HTML::ColHeader("Ratio"));
+    for (unsigned int row = 0; row < 10000; ++row) {
+        table << (HTML::Row() << HTML::Col(row) << HTML::Col(row * 1.25, HTML::FloatFormat::fixed(2))
+                              << HTML::Col(1.0 / (row + 1)));
+    }
+    aDocument << std::move(table);
+}
+
+/// Same numeric table, stored by column in a DataTable and formatted at render time
+static void buildNumberDataTable(HTML::Document& aDocument) {
+    std::vector<long long> ids;
+    std::vector<double> prices;
+    std::vector<double> ratios;
+    for (unsigned int row = 0; row < 10000; ++row) {
+        ids.push_back(row);
+        prices.push_back(row * 1.25);
+        ratios.push_back(1.0 / (row + 1));
+    }
+    HTML::DataTable table;
+    table.cls("table table-sm");
+    table.addColumn("Id", std::move(ids))
+        .addColumn("Price", std::move(prices), HTML::FloatFormat::fixed(2))
+        .addColumn("Ratio", std::move(ratios));
+    aDocument << std::move(table);
+}
+
+/// Deeply nested tree of 500 Div
+static HTML::Div buildDiv(const unsigned int aDepth) {
+    HTML::Div div("level");
+    div << HTML::Span("depth " + std::to_string(aDepth));
+    if (aDepth > 0) {
+        div << buildDiv(aDepth - 1);
+    }
+    return div;
+}
+static void buildNested(HTML::Document& aDocument) {
+    aDocument << buildDiv(500);
+}
+
+/// Form of 500 inputs with many attributes
+static void buildForm(HTML::Document& aDocument) {
+    HTML::Form form("/submit", "post");
+    for (unsigned int idx = 0; idx < 500; ++idx) {
+        const std::string name = "field_" + std::to_string(idx);
+        form << HTML::InputText(name.c_str(), "value").id(name).cls("form-control").title("Field title")
+            .style("width:100%").placeholder("Type here").size(32).maxlength(64).required().autofocus();
+        form << HTML::InputNumber("number").min(0).max(100).addAttribute("step"_name, 5).addAttribute("data-x"_name, "y");
+    }
+    aDocument << std::move(form);
+}
+
+/// The Bootstrap page of the example src/Main.cpp
+static void buildPage(HTML::Document& aDocument) {
+    aDocument.addAttribute("lang"_name, "en");
+    aDocument.head() << HTML::Meta("utf-8")
+        << HTML::Meta("viewport", "width=device-width, initial-scale=1, shrink-to-fit=no");
+    aDocument.head() << HTML::Rel("stylesheet",
+        "https://stackpath.bootstrapcdn.com/bootstrap/4.3.1/css/bootstrap.min.css")
+        .integrity("sha384-ggOyR0iXCbMQv3Xipma34MD+dH/1fQ784/j6cY/iJTQUOhcWr7x9JvoRxT2MZw1T").crossorigin("anonymous");
+    aDocument.head() << HTML::Style(".navbar{margin-bottom:20px;}");
+    aDocument.body().cls("bg-light");
+
+    HTML::List navList(false, "navbar-nav mr-auto");
+    navList << std::move(HTML::ListItem().cls("nav-item active") << HTML::Link("Home", "#").cls("nav-link"));
+    navList << std::move(HTML::ListItem().cls("nav-item") << HTML::Link("Link", "#").cls("nav-link"));
+    navList << std::move(HTML::ListItem().cls("nav-item") << HTML::Link("Disabled", "#").cls("nav-link disabled"));
+    navList << std::move(HTML::ListItem().cls("nav-item dropdown")
+        << HTML::Link("Dropdown", "#").cls("nav-link dropdown-toggle").id("dropdown01")
+            .addAttribute("data-toggle"_name, "dropdown").addAttribute("aria-haspopup"_name, "true")
+            .addAttribute("aria-expanded"_name, "false")
+        << (HTML::Div("dropdown-menu").addAttribute("aria-labelledby"_name, "dropdown01")
+            << HTML::Link("Action", "#").cls("dropdown-item")
+            << HTML::Link("Another", "#").cls("dropdown-item")));
+    aDocument << (HTML::Nav("navbar navbar-expand navbar-dark bg-dark")
+        << (HTML::Div("collapse navbar-collapse") << std::move(navList)));
+
+    HTML::Div main("container");
+    main << HTML::Header1("Welcome to HTML").id("anchor_link_1");
+    main << "Text directly in the body.";
+    main << HTML::Text("Text directly in the body. ") << HTML::Text("Text directly in the body.") << HTML::Break()
+        << HTML::Text("Text directly in the body.");
+    main << HTML::Paragraph("This is the way to go for a big text in a multi-line paragraph.");
+    main << HTML::Link("Google", "http://google.com").cls("my_style");
+    main << (HTML::Paragraph("A paragraph. ").style("font-family:arial")
+        << HTML::Text("Text child.") << HTML::Break() << HTML::Text("And more text."));
+    main << (HTML::List()
+        << (HTML::ListItem("Text item"))
+        << (HTML::ListItem() << HTML::Link("Github Link", "http://srombauts.github.io").title("SRombaut's Github"))
+        << (HTML::ListItem() << (HTML::List() << HTML::ListItem("val1") << HTML::ListItem("val2"))));
+    main << (HTML::Table().cls("table table-hover table-sm")
+        << HTML::Caption("Table caption")
+        << (HTML::Row() << HTML::ColHeader("A") << HTML::ColHeader("B"))
+        << (HTML::Row() << HTML::Col("Cell_11") << HTML::Col("Cell_12"))
+        << (HTML::Row() << HTML::Col("Cell_21") << (HTML::Col() << HTML::Link("Wikipedia", "https://www.wikipedia.org/")))
+        << (HTML::Row() << HTML::Col("") << HTML::Col("Cell_32")));
+    main << HTML::Small("Copyright Sebastien Rombauts @ 2017-2019");
+    main << HTML::Link().id("anchor_link_2");
+    aDocument << std::move(main);
+
+    aDocument << HTML::Script("https://code.jquery.com/jquery-3.3.1.slim.min.js")
+        .integrity("sha384-q8i/X+965DzO0rT7abK41JStQIAqVgRVzpbzo5smXKp4YfRvH+8abtTE1Pi6jizo").crossorigin("anonymous");
+    aDocument << HTML::Script("https://cdnjs.cloudflare.com/ajax/libs/popper.js/1.14.7/umd/popper.min.js")
+        .integrity("sha384-UO2eT0CpHqdSJQ6hJty5KVphtPhzWj9WO1clHTMGa3JDZwrnQq4sF86dIHNDz0W1").crossorigin("anonymous");
+    aDocument << HTML::Script("https://stackpath.bootstrapcdn.com/bootstrap/4.3.1/js/bootstrap.min.js")
+        .integrity("sha384-JjSmVgyd0p3pXB1rRibZUAYoIIy6OrQ6VrjIEaFf/nJGzIxFDsf4x0xIM+B07jRM").crossorigin("anonymous");
+}
+
+/// Article of 100 paragraphs of 4KB of text, the shared navigation being a frozen Fragment
+static void buildArticle(HTML::Document& aDocument) {
+    static const HTML::Fragment navbar = (HTML::Nav("navbar navbar-expand navbar-dark bg-dark")
+        << (HTML::List().cls("navbar-nav")
+            << (HTML::ListItem().cls("nav-item") << HTML::Link("Home", "#").cls("nav-link"))
+            << (HTML::ListItem().cls("nav-item") << HTML::Link("Articles", "#").cls("nav-link")))).freeze();
+    aDocument << HTML::Fragment(navbar);
+    HTML::Div main("container");
+    main << HTML::Header1("Article");
+    std::string text;
+    for (unsigned int sentence = 0; text.size() < 4000; ++sentence) {
+        text += "Sentence number " + std::to_string(sentence) + " of a long paragraph of content. ";
+    }
+    for (unsigned int paragraph = 0; paragraph < 100; ++paragraph) {
+        main << HTML::Paragraph(text);
+    }
+    aDocument << std::move(main);
+}
+
+/// Navigation bar of 8 menus of 12 links, embedded in every page of a site
+static HTML::Element buildNavigation() {
+    HTML::List menus(false, "navbar-nav mr-auto");
+    for (unsigned int menu = 0; menu < 8; ++menu) {
+        HTML::Div links("dropdown-menu");
+        for (unsigned int link = 0; link < 12; ++link) {
+            links << HTML::Link("Page " + std::to_string(link), "/menu/" + std::to_string(menu) + "/page/" +
+                                std::to_string(link)).cls("dropdown-item");
+        }
+        menus << (HTML::ListItem().cls("nav-item dropdown")
+            << HTML::Link("Menu " + std::to_string(menu), "#").cls("nav-link dropdown-toggle")
+            << std::move(links));
+    }
+    return std::move(HTML::Nav("navbar navbar-expand navbar-dark bg-dark")
+        << (HTML::Div("collapse navbar-collapse") << std::move(menus)));
+}
+
+typedef void (*Builder)(HTML::Document& aDocument);
+
+/// Report the bytes processed per second and the number of heap allocations per node
+static void report(benchmark::State& aState, const size_t aBytes, const size_t aNodes, const size_t aAllocations) {
+    aState.SetBytesProcessed(static_cast<int64_t>(aState.iterations() * aBytes));
+    aState.counters["nodes"] = static_cast<double>(aNodes);
+    aState.counters["allocs/node"] = benchmark::Counter(static_cast<double>(aAllocations) / static_cast<double>(aNodes),
+                                                        benchmark::Counter::kAvgIterations);
+}
+
+/// Construction of the Document
+static void BM_Build(benchmark::State& aState, Builder aBuilder) {
+    size_t bytes = 0;
+    size_t nodes = 0;
+    {
+        HTML::Document document("Benchmark");
+        aBuilder(document);
+        const std::string html = document.toString();
+        bytes = html.size();
+        nodes = countNodes(html);
+    }
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        HTML::Document document("Benchmark");
+        aBuilder(document);
+        benchmark::DoNotOptimize(&document);
+    }
+    report(aState, bytes, nodes, sAllocations - allocations);
+}
+
+/// Construction of the Document in the recycled arena of the thread
+static void BM_BuildPooled(benchmark::State& aState, Builder aBuilder) {
+    size_t bytes = 0;
+    size_t nodes = 0;
+    {
+        HTML::PooledDocument document("Benchmark");
+        aBuilder(*document);
+        const std::string html = document->toString();
+        bytes = html.size();
+        nodes = countNodes(html);
+    }
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        HTML::PooledDocument document("Benchmark");
+        aBuilder(*document);
+        benchmark::DoNotOptimize(&document);
+    }
+    report(aState, bytes, nodes, sAllocations - allocations);
+}
+
+/// Memory used by a built Document: bytes and blocks of its Elements per node, excluding the long strings
+static void BM_Memory(benchmark::State& aState, Builder aBuilder) {
+    size_t nodes = 0;
+    size_t bytes = 0;
+    size_t blocks = 0;
+    for (auto _ : aState) {
+        HTML::CountingResource resource;
+        HTML::ScopedResource scope(resource);
+        HTML::Document document("Benchmark");
+        aBuilder(document);
+        bytes = resource.bytes() + sizeof(HTML::Document);
+        blocks = resource.blocks();
+        aState.PauseTiming();
+        nodes = countNodes(document.toString());
+        aState.ResumeTiming();
+    }
+    aState.counters["nodes"] = static_cast<double>(nodes);
+    aState.counters["sizeof(Element)"] = static_cast<double>(sizeof(HTML::Element));
+    aState.counters["bytes/node"] = static_cast<double>(bytes) / static_cast<double>(nodes);
+    aState.counters["blocks/node"] = static_cast<double>(blocks) / static_cast<double>(nodes);
+}
+
+/// Copy of a template Document completed for each request, sharing its unchanged Elements
+static void BM_Clone(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        HTML::Document clone = document;
+        clone << HTML::Paragraph("Request");
+        benchmark::DoNotOptimize(&clone);
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Serialization of a Template of the Document with a slot set for each request, the rest being cached
+static void BM_Template(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    document << HTML::Slot("request"_name);
+    HTML::Template page(document);
+    page.set("request", HTML::Paragraph("Request"));
+    const std::string html = page.toString();
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        page.set("request", HTML::Paragraph("Request"));
+        std::string result = page.toString();
+        benchmark::DoNotOptimize(result.data());
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Patches between two Documents built separately, the second one with an additional paragraph
+static void BM_Diff(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document previous("Benchmark");
+    aBuilder(previous);
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    document << HTML::Paragraph("Request");
+    const std::string html = document.toString();
+    const size_t allocations = sAllocations;
+    size_t bytes = 0;
+    for (auto _ : aState) {
+        const HTML::Diff diff(previous, document);
+        bytes = diff.toJson().size();
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+    aState.counters["patch_bytes"] = static_cast<double>(bytes);
+}
+
+/// Lookup of the last Element with an id in the indexed Document, then of the Elements of the most common class
+static void BM_GetElementById(benchmark::State& aState, Builder aBuilder, const char* apId, const char* apClass) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    document.getElementById(apId); // build the index
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        benchmark::DoNotOptimize(document.getElementById(apId));
+        benchmark::DoNotOptimize(document.getElementsByClass(apClass).size());
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Indexing of the ids and classes of a cloned Document, at its first lookup
+static void BM_Index(benchmark::State& aState, Builder aBuilder, const char* apId, const char*) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        HTML::Document clone = document;
+        benchmark::DoNotOptimize(clone.getElementById(apId));
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+/// Hash of the Document for its ETag, without generating its HTML in memory
+static void BM_ETag(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        HTML::ContentHash hash;
+        document.appendTo(hash);
+        benchmark::DoNotOptimize(hash.digest());
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Serialization of the Document to a new std::string, hashed at the same time for its ETag
+static void BM_ToStringHashed(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        std::string result;
+        result.reserve(document.renderedSize());
+        HTML::HashingOutput output(result);
+        document.appendTo(output);
+        benchmark::DoNotOptimize(output.hash().digest());
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Serialization of the Document to a new std::string
+static void BM_ToString(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        std::string result = document.toString();
+        benchmark::DoNotOptimize(result.data());
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Serialization of the same Document flattened into a FlatDocument
+static void BM_ToStringFlat(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const HTML::FlatDocument flat(document);
+    const std::string html = flat.toString();
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        std::string result = flat.toString();
+        benchmark::DoNotOptimize(result.data());
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Serialization of the Document to a std::ostream
+static void BM_Stream(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    NullBuffer buffer;
+    std::ostream stream(&buffer);
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        stream << document;
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Serialization of the Document into a reused caller-owned buffer
+static void BM_AppendTo(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    std::string buffer;
+    buffer.reserve(html.size());
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        buffer.clear();
+        document.appendTo(buffer);
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Serialization of the Document to a new std::string, the large lists of children on all cores
+static void BM_ToStringParallel(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    const HTML::ParallelPolicy policy(256);
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        std::string result = document.toString(policy);
+        benchmark::DoNotOptimize(result.data());
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Serialization of the Document to a new std::string, without indentation nor end of line
+static void BM_ToStringMinified(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString<HTML::Minified>();
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        std::string result = document.toString<HTML::Minified>();
+        benchmark::DoNotOptimize(result.data());
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Serialization of the Document to a new std::string, then written to a Sink
+static void BM_Send(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    NullSink sink;
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        const std::string result = document.toString();
+        sink.write(result.data(), result.size());
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Serialization of the Document as slices referring to its strings, written to a Sink in batches
+static void BM_SendVectored(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    NullSink sink;
+    HTML::VectoredOutput output(sink);
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        document.appendTo(output);
+        output.flush();
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+#if HTML_ZLIB
+/// Serialization of the Document to a new std::string, then compressed with gzip to a Sink
+static void BM_SendGzip(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        NullSink sink;
+        HTML::GzipSink gzip(sink);
+        const std::string result = document.toString();
+        gzip.write(result.data(), result.size());
+        gzip.finish();
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Serialization of the Document as slices compressed on the fly with gzip, without the whole uncompressed page
+static void BM_StreamGzip(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    size_t compressed = 0;
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        NullSink sink;
+        HTML::GzipSink gzip(sink);
+        HTML::VectoredOutput output(gzip);
+        document.appendTo(output);
+        output.flush();
+        gzip.finish();
+        compressed = sink.mSize;
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+    aState.counters["compressed_bytes"] = static_cast<double>(compressed);
+}
+#endif
+
+#if HTML_BROTLI
+/// Serialization of the Document as slices compressed on the fly with brotli, at the default quality
+static void BM_StreamBrotli(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    size_t compressed = 0;
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        NullSink sink;
+        HTML::BrotliSink brotli(sink);
+        HTML::VectoredOutput output(brotli);
+        document.appendTo(output);
+        output.flush();
+        brotli.finish();
+        compressed = sink.mSize;
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+    aState.counters["compressed_bytes"] = static_cast<double>(compressed);
+}
+#endif
+
+/// Serialization of the Document in chunks of 16KB given to a callback, with a constant memory usage
+static void BM_Chunked(benchmark::State& aState, Builder aBuilder) {
+    HTML::Document document("Benchmark");
+    aBuilder(document);
+    const std::string html = document.toString();
+    size_t size = 0;
+    const size_t allocations = sAllocations;
+    for (auto _ : aState) {
+        HTML::ChunkedWriter writer(document, [&size](const char* apData, size_t aSize) {
+            benchmark::DoNotOptimize(apData);
+            size += aSize;
+            return true;
+        });
+        writer.resume();
+    }
+    report(aState, html.size(), countNodes(html), sAllocations - allocations);
+}
+
+/// Pages built and serialized by each thread concurrently, embedding the same navigation bar, shared or copied
+static void BM_ConcurrentPages(benchmark::State& aState, const bool abShared) {
+    static const HTML::Element navigation = buildNavigation();
+    static const HTML::Shared sharedNavigation(navigation);
+    std::string buffer;
+    size_t bytes = 0;
+    for (auto _ : aState) {
+        HTML::PooledDocument page("Benchmark");
+        if (abShared) {
+            page->body() << HTML::Shared(sharedNavigation);
+        } else {
+            page->body() << HTML::Element(navigation); // deep copy, in the arena of the thread
+        }
+        page->body() << HTML::Paragraph("Request");
+        buffer.clear();
+        page->appendTo(buffer);
+        bytes = buffer.size();
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    aState.SetBytesProcessed(static_cast<int64_t>(aState.iterations() * bytes));
+}
+
+BENCHMARK_CAPTURE(BM_Build, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_Build, DataTable, &buildDataTable);
+BENCHMARK_CAPTURE(BM_Build, Nested, &buildNested);
+BENCHMARK_CAPTURE(BM_Build, Form, &buildForm);
+BENCHMARK_CAPTURE(BM_Build, Page, &buildPage);
+BENCHMARK_CAPTURE(BM_Build, Numbers, &buildNumbers);
+BENCHMARK_CAPTURE(BM_Build, NumberDataTable, &buildNumberDataTable);
+
+BENCHMARK_CAPTURE(BM_BuildPooled, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_BuildPooled, Form, &buildForm);
+BENCHMARK_CAPTURE(BM_BuildPooled, Page, &buildPage);
+
+BENCHMARK_CAPTURE(BM_Clone, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_Clone, Page, &buildPage);
+
+BENCHMARK_CAPTURE(BM_Memory, Page, &buildPage);
+BENCHMARK_CAPTURE(BM_Memory, LongTable, &buildLongTable);
+
+BENCHMARK_CAPTURE(BM_ToString, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_ToString, DataTable, &buildDataTable);
+BENCHMARK_CAPTURE(BM_ToString, Nested, &buildNested);
+BENCHMARK_CAPTURE(BM_ToString, Form, &buildForm);
+BENCHMARK_CAPTURE(BM_ToString, Page, &buildPage);
+BENCHMARK_CAPTURE(BM_ToString, Numbers, &buildNumbers);
+BENCHMARK_CAPTURE(BM_ToString, NumberDataTable, &buildNumberDataTable);
+
+BENCHMARK_CAPTURE(BM_ETag, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_ETag, Page, &buildPage);
+
+BENCHMARK_CAPTURE(BM_ToStringHashed, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_ToStringHashed, Page, &buildPage);
+
+BENCHMARK_CAPTURE(BM_Template, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_Template, Page, &buildPage);
+
+BENCHMARK_CAPTURE(BM_Diff, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_Diff, Page, &buildPage);
+
+BENCHMARK_CAPTURE(BM_GetElementById, Form, &buildForm, "field_499", "form-control");
+BENCHMARK_CAPTURE(BM_GetElementById, Page, &buildPage, "anchor_link_1", "nav-item");
+
+BENCHMARK_CAPTURE(BM_Index, Form, &buildForm, "field_499", "form-control");
+BENCHMARK_CAPTURE(BM_Index, Page, &buildPage, "anchor_link_1", "nav-item");
+
+BENCHMARK_CAPTURE(BM_ToStringFlat, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_ToStringFlat, Nested, &buildNested);
+BENCHMARK_CAPTURE(BM_ToStringFlat, Form, &buildForm);
+BENCHMARK_CAPTURE(BM_ToStringFlat, Page, &buildPage);
+
+BENCHMARK_CAPTURE(BM_Stream, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_Stream, Nested, &buildNested);
+BENCHMARK_CAPTURE(BM_Stream, Form, &buildForm);
+BENCHMARK_CAPTURE(BM_Stream, Page, &buildPage);
+
+BENCHMARK_CAPTURE(BM_AppendTo, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_AppendTo, Nested, &buildNested);
+BENCHMARK_CAPTURE(BM_AppendTo, Form, &buildForm);
+BENCHMARK_CAPTURE(BM_AppendTo, Page, &buildPage);
+
+BENCHMARK_CAPTURE(BM_ToStringParallel, Table, &buildTable)->UseRealTime();
+BENCHMARK_CAPTURE(BM_ToStringParallel, Form, &buildForm)->UseRealTime();
+
+BENCHMARK_CAPTURE(BM_ToStringMinified, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_ToStringMinified, Nested, &buildNested);
+BENCHMARK_CAPTURE(BM_ToStringMinified, Page, &buildPage);
+
+BENCHMARK_CAPTURE(BM_Send, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_Send, Page, &buildPage);
+BENCHMARK_CAPTURE(BM_Send, Article, &buildArticle);
+
+BENCHMARK_CAPTURE(BM_SendVectored, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_SendVectored, Page, &buildPage);
+BENCHMARK_CAPTURE(BM_SendVectored, Article, &buildArticle);
+
+#if HTML_ZLIB
+BENCHMARK_CAPTURE(BM_SendGzip, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_SendGzip, Page, &buildPage);
+
+BENCHMARK_CAPTURE(BM_StreamGzip, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_StreamGzip, Page, &buildPage);
+#endif
+
+#if HTML_BROTLI
+BENCHMARK_CAPTURE(BM_StreamBrotli, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_StreamBrotli, Page, &buildPage);
+#endif
+
+BENCHMARK_CAPTURE(BM_Chunked, Table, &buildTable);
+BENCHMARK_CAPTURE(BM_Chunked, Page, &buildPage);
+BENCHMARK_CAPTURE(BM_Chunked, Article, &buildArticle);
+
+BENCHMARK_CAPTURE(BM_ConcurrentPages, Shared, true)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_CAPTURE(BM_ConcurrentPages, Copied, false)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
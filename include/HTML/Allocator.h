@@ -0,0 +1,313 @@
+/**
+ * @file    Allocator.h
+ * @ingroup HtmlBuilder
+ * @brief   Memory resources and polymorphic allocator used by the Elements of the HTML Document Object Model.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <new>
+#include <type_traits>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Abstract source of memory for the Elements of a Document, like the C++17 std::pmr::memory_resource.
+ */
+class MemoryResource {
+public:
+    virtual ~MemoryResource() {}
+
+    virtual void* allocate(size_t aBytes, size_t aAlignment) = 0;
+    virtual void deallocate(void* apMemory, size_t aBytes, size_t aAlignment) = 0;
+};
+
+/// Default MemoryResource using the global operator new and operator delete
+class NewDeleteResource : public MemoryResource {
+public:
+    void* allocate(size_t aBytes, size_t) override {
+        return ::operator new(aBytes);
+    }
+    void deallocate(void* apMemory, size_t, size_t) override {
+        ::operator delete(apMemory);
+    }
+};
+
+/// Get the default MemoryResource, shared by all threads
+inline MemoryResource& newDeleteResource() {
+    static NewDeleteResource resource;
+    return resource;
+}
+
+/**
+ * @brief Monotonic arena: a MemoryResource allocating from big blocks, freed all at once.
+ *
+ *   Allocation is a simple pointer bump and deallocation is a no-op, so building a whole page in an arena
+ * costs a few mallocs instead of several per Element, and destroying it is a single release().
+ *
+ * @warning Every Element built in the arena must be destroyed before the arena is released or destroyed.
+ */
+class MonotonicArena : public MemoryResource {
+public:
+    explicit MonotonicArena(const size_t aBlockSize = 64 * 1024) : mBlockSize(aBlockSize) {}
+    ~MonotonicArena() override {
+        release();
+    }
+
+    MonotonicArena(const MonotonicArena&) = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    void* allocate(size_t aBytes, size_t aAlignment) override {
+        size_t padding = (aAlignment - (reinterpret_cast<uintptr_t>(mpCurrent) % aAlignment)) % aAlignment;
+        if ((nullptr == mpCurrent) || (padding + aBytes > mRemaining)) {
+            newBlock(aBytes + aAlignment);
+            padding = (aAlignment - (reinterpret_cast<uintptr_t>(mpCurrent) % aAlignment)) % aAlignment;
+        }
+        void* pMemory = mpCurrent + padding;
+        mpCurrent += padding + aBytes;
+        mRemaining -= padding + aBytes;
+        return pMemory;
+    }
+    void deallocate(void*, size_t, size_t) override {
+        // Memory is only reclaimed by release()
+    }
+
+    /// Free all the memory allocated by the arena in one step
+    void release() {
+        while (mpBlocks) {
+            Block* pNext = mpBlocks->mpNext;
+            ::operator delete(mpBlocks);
+            mpBlocks = pNext;
+        }
+        mpCurrent = nullptr;
+        mRemaining = 0;
+        mAllocated = 0;
+    }
+
+    /**
+     * @brief Make all the memory of the arena available again, keeping it allocated for the next Document.
+     *
+     *   The blocks are merged into a single one of their total size, so that a Document of the same size
+     * is then built again without any allocation from the global heap.
+     */
+    void reset() {
+        if (mpBlocks && mpBlocks->mpNext) {
+            const size_t size = mAllocated;
+            release();
+            newBlock(size - sizeof(Block));
+        } else if (mpBlocks) {
+            mpCurrent = reinterpret_cast<char*>(mpBlocks) + sizeof(Block);
+            mRemaining = mAllocated - sizeof(Block);
+        }
+    }
+
+    /// Total size of the blocks allocated from the global heap by the arena
+    size_t allocated() const {
+        return mAllocated;
+    }
+
+private:
+    /// Header of each block of memory, chained to the previous block
+    struct Block {
+        Block* mpNext;
+    };
+
+    void newBlock(const size_t aMinSize) {
+        const size_t size = sizeof(Block) + (aMinSize > mBlockSize ? aMinSize : mBlockSize);
+        Block* pBlock = static_cast<Block*>(::operator new(size));
+        pBlock->mpNext = mpBlocks;
+        mpBlocks = pBlock;
+        mpCurrent = reinterpret_cast<char*>(pBlock) + sizeof(Block);
+        mRemaining = size - sizeof(Block);
+        mAllocated += size;
+    }
+
+private:
+    const size_t mBlockSize;        ///< Default size of each block requested to the global heap
+    Block*       mpBlocks = nullptr;    ///< Last allocated block, head of the list of blocks
+    char*        mpCurrent = nullptr;   ///< First free byte in the last block
+    size_t       mRemaining = 0;        ///< Number of free bytes in the last block
+    size_t       mAllocated = 0;        ///< Total number of bytes allocated from the global heap
+};
+
+/// Get a reference to the MemoryResource currently used by the calling thread to build new Elements
+inline MemoryResource*& currentResourcePtr() {
+    static thread_local MemoryResource* pResource = nullptr;
+    return pResource;
+}
+
+/// Get the MemoryResource currently used by the calling thread to build new Elements
+inline MemoryResource& currentResource() {
+    MemoryResource* pResource = currentResourcePtr();
+    return pResource ? *pResource : newDeleteResource();
+}
+
+/**
+ * @brief RAII guard selecting the MemoryResource used by all the Elements built by the current thread.
+ *
+ * @code
+    HTML::MonotonicArena arena;
+    {
+        HTML::ScopedResource scope(arena);
+        HTML::Document document("Built in an arena");
+        document << (HTML::Table() << (HTML::Row() << HTML::Col("Cell")));
+        send(document.toString());
+    } // the Document is destroyed before the arena
+ * @endcode
+ *
+ *   The scopes of a thread may end in any order, like those of the PooledDocuments held by different objects:
+ * a scope ending before a more recent one passes the resource to restore on to it, instead of restoring it.
+ *
+ * @warning A scope must end on the thread where it began: std::terminate() is called otherwise.
+ */
+class ScopedResource {
+public:
+    explicit ScopedResource(MemoryResource& aResource) : mpPrevious(currentResourcePtr()), mpOuter(innermost()) {
+        currentResourcePtr() = &aResource;
+        innermost() = this;
+    }
+    ~ScopedResource() {
+        if (innermost() == this) {
+            currentResourcePtr() = mpPrevious;
+            innermost() = mpOuter;
+            return;
+        }
+        // Note: the more recent scopes still select their own resource, the one of which this scope was the outer
+        // one restores the resource preceding this scope instead
+        for (ScopedResource* pInner = innermost(); pInner; pInner = pInner->mpOuter) {
+            if (pInner->mpOuter == this) {
+                pInner->mpPrevious = mpPrevious;
+                pInner->mpOuter = mpOuter;
+                return;
+            }
+        }
+        // Note: a scope ending on another thread would leave its resource selected on its own thread
+        std::terminate();
+    }
+
+    ScopedResource(const ScopedResource&) = delete;
+    ScopedResource& operator=(const ScopedResource&) = delete;
+
+private:
+    /// Most recent scope of the calling thread
+    static ScopedResource*& innermost() {
+        static thread_local ScopedResource* pScope = nullptr;
+        return pScope;
+    }
+
+private:
+    MemoryResource* mpPrevious; ///< Resource to restore at the end of the scope
+    ScopedResource* mpOuter;    ///< Scope preceding this one on the thread, if any
+};
+
+/**
+ * @brief MemoryResource counting the allocations of the Elements, forwarded to an upstream resource.
+ *
+ *   Selected with a ScopedResource, it measures the memory used to build a Document and its copies
+ * (the attributes and children of the Elements; long strings are allocated by std::string, see RenderStats).
+ */
+class CountingResource : public MemoryResource {
+public:
+    explicit CountingResource(MemoryResource& aUpstream = currentResource()) : mUpstream(aUpstream) {}
+
+    void* allocate(size_t aBytes, size_t aAlignment) override {
+        void* pMemory = mUpstream.allocate(aBytes, aAlignment);
+        ++mAllocations;
+        ++mBlocks;
+        mAllocatedBytes += aBytes;
+        mBytes += aBytes;
+        mPeakBytes = (mBytes > mPeakBytes) ? mBytes : mPeakBytes;
+        return pMemory;
+    }
+    void deallocate(void* apMemory, size_t aBytes, size_t aAlignment) override {
+        mUpstream.deallocate(apMemory, aBytes, aAlignment);
+        --mBlocks;
+        mBytes -= aBytes;
+    }
+
+    /// Number of allocations since the construction of the resource
+    size_t allocations() const {
+        return mAllocations;
+    }
+    /// Number of bytes allocated since the construction of the resource
+    size_t allocatedBytes() const {
+        return mAllocatedBytes;
+    }
+    /// Number of blocks currently allocated
+    size_t blocks() const {
+        return mBlocks;
+    }
+    /// Number of bytes currently allocated
+    size_t bytes() const {
+        return mBytes;
+    }
+    /// Highest number of bytes allocated at once
+    size_t peakBytes() const {
+        return mPeakBytes;
+    }
+
+private:
+    MemoryResource& mUpstream;              ///< Resource providing the memory
+    size_t          mAllocations = 0;       ///< Number of allocations
+    size_t          mAllocatedBytes = 0;    ///< Number of bytes allocated
+    size_t          mBlocks = 0;            ///< Number of blocks currently allocated
+    size_t          mBytes = 0;             ///< Number of bytes currently allocated
+    size_t          mPeakBytes = 0;         ///< Highest number of bytes allocated at once
+};
+
+/**
+ * @brief Polymorphic allocator of the containers of an Element, like the C++17 std::pmr::polymorphic_allocator.
+ *
+ *   A default constructed Allocator captures the current resource of the thread (see ScopedResource),
+ * so the HTML classes need no allocator parameter and the default instance uses the global heap.
+ */
+template<typename T>
+class Allocator {
+public:
+    typedef T value_type;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    Allocator() noexcept : mpResource(&currentResource()) {}
+    explicit Allocator(MemoryResource& aResource) noexcept : mpResource(&aResource) {}
+    template<typename U>
+    Allocator(const Allocator<U>& aOther) noexcept : mpResource(aOther.resource()) {} // NOLINT(runtime/explicit)
+
+    T* allocate(const size_t aCount) {
+        return static_cast<T*>(mpResource->allocate(aCount * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* apMemory, const size_t aCount) {
+        mpResource->deallocate(apMemory, aCount * sizeof(T), alignof(T));
+    }
+
+    /// A copy of an Element uses the current resource of the thread, not the one of the original
+    Allocator select_on_container_copy_construction() const {
+        return Allocator();
+    }
+
+    MemoryResource* resource() const {
+        return mpResource;
+    }
+
+private:
+    MemoryResource* mpResource; ///< Source of the memory, never null
+};
+
+template<typename T, typename U>
+bool operator==(const Allocator<T>& aLeft, const Allocator<U>& aRight) {
+    return aLeft.resource() == aRight.resource();
+}
+template<typename T, typename U>
+bool operator!=(const Allocator<T>& aLeft, const Allocator<U>& aRight) {
+    return aLeft.resource() != aRight.resource();
+}
+
+} // namespace HTML
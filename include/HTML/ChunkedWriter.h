@@ -0,0 +1,265 @@
+/**
+ * @file    ChunkedWriter.h
+ * @ingroup HtmlBuilder
+ * @brief   Resumable serialization of a Document in chunks of fixed size, paused when the consumer is not ready.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Deferred.h"
+#include "Document.h"
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Serialization of a Document in chunks of fixed size given to a callback, with backpressure.
+ *
+ *   The tree is traversed without recursion, one tag or one text at a time, so that the serialization can stop
+ * as soon as the callback returns false, and continue on the next call to resume(). Each chunk has exactly
+ * aChunkSize bytes, except the last one, so the first bytes leave early and the memory used stays constant:
+ * the chunk buffer, and the end of the current tag or text (or Renderable, like a DataTable) if paused in the middle.
+ * The output is byte-identical to Document::toString(aFormat).
+ *
+ *   On reaching a Deferred not yet resolved, the HTML preceding it is sent at once in a shorter chunk,
+ * and resume() returns false until the content of the Deferred is ready (see wait()).
+ *
+ * @code
+    HTML::ChunkedWriter writer(document, [&connection](const char* apData, size_t aSize) {
+        connection.sendChunk(apData, aSize); // HTTP chunked transfer: size in hex, CRLF, data, CRLF
+        return !connection.congested();
+    });
+    while (!writer.resume()) {
+        connection.waitWritable();
+    }
+    connection.sendChunk(nullptr, 0); // last chunk
+ * @endcode
+ *
+ *   The writer keeps a copy of the Document, sharing its subtrees (see SharedVector),
+ * so the Document can be modified or destroyed during the serialization.
+ */
+class ChunkedWriter {
+public:
+    /// Consume a chunk of generated HTML, only valid during the call; return false to pause until resume()
+    typedef std::function<bool(const char* apData, size_t aSize)> Callback;
+
+    static const size_t DefaultChunkSize = 16 * 1024;
+
+    /**
+     * @brief Prepare the serialization of a whole Document, starting with its \<!DOCTYPE\>; nothing is sent yet.
+     *
+     * @param[in] aDocument     Document to serialize
+     * @param[in] aCallback     Consumer of the chunks, returning false to pause the serialization
+     * @param[in] aChunkSize    Size of the chunks, except for the last one
+     * @param[in] aFormat       Layout of the generated HTML
+     */
+    ChunkedWriter(const Document& aDocument, Callback aCallback, const size_t aChunkSize = DefaultChunkSize,
+                  const Format aFormat = Format::Pretty) :
+        ChunkedWriter(static_cast<const Element&>(aDocument), std::move(aCallback), aChunkSize, aFormat) {
+        mbDoctype = true;
+    }
+    /// Prepare the serialization of an Element and its children
+    ChunkedWriter(const Element& aElement, Callback aCallback, const size_t aChunkSize = DefaultChunkSize,
+                  const Format aFormat = Format::Pretty) :
+        mRoot(aElement), mOutput(std::move(aCallback), aChunkSize > 0 ? aChunkSize : 1), mFormat(aFormat) {}
+
+    ChunkedWriter(const ChunkedWriter&) = delete;
+    ChunkedWriter& operator=(const ChunkedWriter&) = delete;
+
+    /**
+     * @brief Serialize and send the chunks, until the callback asks for a pause or until the end of the Document.
+     *
+     * @return true when the serialization is finished and all the chunks sent, false if it was paused
+     *
+     * @throw the failure reported to a Deferred (see Deferred::fail())
+     */
+    bool resume() {
+        mOutput.resume();
+        if (mpWaiting && !mOutput.isPaused()) {
+            if (!mpWaiting->isReady()) {
+                return false;
+            }
+            const Deferred::State* pState = mpWaiting;
+            mpWaiting = nullptr;
+            if (Format::Minified == mFormat) {
+                openDeferred<Minified>(*pState, mWaitingIndentation);
+            } else {
+                openDeferred<Pretty>(*pState, mWaitingIndentation);
+            }
+        }
+        while (!mbFinished && !mpWaiting && !mOutput.isPaused()) {
+            if (Format::Minified == mFormat) {
+                step<Minified>();
+            } else {
+                step<Pretty>();
+            }
+        }
+        return mbFinished;
+    }
+
+    /// Is the serialization finished, all the chunks being sent
+    bool isFinished() const {
+        return mbFinished;
+    }
+
+    /// Is the serialization waiting for the content of a Deferred
+    bool isWaiting() const {
+        return mpWaiting && !mpWaiting->isReady();
+    }
+
+    /**
+     * @brief Call aOnReady once the content of the Deferred is ready, unless the writer is not waiting for it.
+     *
+     *   aOnReady is called by the thread resolving the Deferred, and is expected to schedule a call to resume().
+     *
+     * @return a token cancelling the call when destroyed, or an empty token if resume() can be called right away
+     */
+    Deferred::WaitToken wait(std::function<void()> aOnReady) const {
+        return mpWaiting ? mpWaiting->wait(std::move(aOnReady)) : Deferred::WaitToken();
+    }
+
+private:
+    /// Output with the std::string append interface, sending each chunk as soon as it is full unless paused
+    class ChunkOutput {
+    public:
+        ChunkOutput(Callback&& aCallback, const size_t aChunkSize) :
+            mCallback(std::move(aCallback)), mChunkSize(aChunkSize) {
+            mBuffer.reserve(aChunkSize);
+        }
+
+        void append(const char* apData, size_t aSize) {
+            while (!mbPaused && (mBuffer.size() + aSize >= mChunkSize)) {
+                const size_t size = mChunkSize - mBuffer.size();
+                mBuffer.append(apData, size);
+                apData += size;
+                aSize -= size;
+                mbPaused = !mCallback(mBuffer.data(), mBuffer.size());
+                mBuffer.clear();
+            }
+            mBuffer.append(apData, aSize);
+        }
+        /// Append the indentation
+        void append(size_t aCount, char) {
+            static const char spaces[] = "                                                                ";
+            for (; aCount >= sizeof(spaces) - 1; aCount -= sizeof(spaces) - 1) {
+                append(spaces, sizeof(spaces) - 1);
+            }
+            append(spaces, aCount);
+        }
+        void operator+=(const char aChar) {
+            append(&aChar, 1);
+        }
+        void operator+=(const std::string& aString) {
+            append(aString.data(), aString.size());
+        }
+
+        bool isPaused() const {
+            return mbPaused;
+        }
+
+        /// Send the full chunks buffered while paused
+        void resume() {
+            mbPaused = false;
+            size_t offset = 0;
+            for (; !mbPaused && (mBuffer.size() - offset >= mChunkSize); offset += mChunkSize) {
+                mbPaused = !mCallback(mBuffer.data() + offset, mChunkSize);
+            }
+            mBuffer.erase(0, offset);
+        }
+
+        /// Send the buffered HTML at once, in a chunk shorter than the others
+        void flush() {
+            if (!mBuffer.empty()) {
+                mbPaused = !mCallback(mBuffer.data(), mBuffer.size());
+                mBuffer.clear();
+            }
+        }
+
+    private:
+        Callback        mCallback;          ///< Consumer of the chunks
+        const size_t    mChunkSize;         ///< Size of the chunks, except for the last one
+        std::string     mBuffer;            ///< HTML not yet sent, exceeding the chunk size only while paused
+        bool            mbPaused = false;   ///< The callback asked for a pause
+    };
+
+    /// Opened Element, whose children are being serialized
+    struct Frame {
+        const Element*  mpElement;
+        size_t          mIndentation;
+        size_t          mNextChild;     ///< Index of the next child to serialize
+    };
+
+    /// Serialize the next tag or text: the opening tag of the Element or of its next child, or its closing tag
+    template<typename Layout>
+    void step() {
+        if (!mbStarted) {
+            mbStarted = true;
+            if (mbDoctype) {
+                Element::append(mOutput, "<!DOCTYPE html>");
+                Layout::endline(mOutput);
+            }
+            open<Layout>(mRoot, 0);
+        } else if (mFrames.empty()) {
+            mOutput.flush();
+            mbFinished = true;
+        } else if (mFrames.back().mNextChild < mFrames.back().mpElement->mChildren.size()) {
+            Frame& frame = mFrames.back();
+            const Element& child = frame.mpElement->mChildren[frame.mNextChild++];
+            open<Layout>(child, frame.mIndentation + Layout::Indentation);
+        } else {
+            const Frame& frame = mFrames.back();
+            frame.mpElement->toStringClose<Layout>(mOutput, frame.mIndentation);
+            mFrames.pop_back();
+        }
+    }
+
+    /// Serialize the opening tag and the text of a named Element, to continue with its children, or a whole leaf
+    template<typename Layout>
+    void open(const Element& aElement, const size_t aIndentation) {
+        if (aElement.mbDeferred) {
+            const Deferred::State& state = static_cast<const Deferred::State&>(*aElement.mpRenderable);
+            if (state.isReady()) {
+                openDeferred<Layout>(state, aIndentation);
+            } else {
+                mpWaiting = &state;
+                mWaitingIndentation = aIndentation;
+                mOutput.flush();
+            }
+        } else if (aElement.mpRenderable || aElement.mName.empty()) {
+            aElement.render<Layout>(mOutput, aIndentation);
+        } else {
+            aElement.toStringOpen<Layout>(mOutput, aIndentation);
+            aElement.toStringText(mOutput);
+            mFrames.push_back({&aElement, aIndentation, 0});
+        }
+    }
+
+    /// Serialize the content of a Deferred like any child, or throw its failure
+    template<typename Layout>
+    void openDeferred(const Deferred::State& aState, const size_t aIndentation) {
+        aState.rethrow();
+        open<Layout>(*aState.content(), aIndentation);
+    }
+
+private:
+    const Element           mRoot;                      ///< Copy of the Document, sharing its subtrees
+    ChunkOutput             mOutput;                    ///< Chunk being filled
+    const Format            mFormat;                    ///< Layout of the generated HTML
+    std::vector<Frame>      mFrames;                    ///< Stack of opened Elements, starting with the root
+    const Deferred::State*  mpWaiting = nullptr;        ///< Deferred whose content is awaited, if any
+    size_t                  mWaitingIndentation = 0;    ///< Indentation of this Deferred
+    bool                    mbDoctype = false;          ///< Start with the \<!DOCTYPE\> of a Document
+    bool                    mbStarted = false;          ///< The root Element is opened
+    bool                    mbFinished = false;         ///< The last chunk is sent
+};
+
+} // namespace HTML
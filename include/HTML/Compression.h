@@ -0,0 +1,263 @@
+/**
+ * @file    Compression.h
+ * @ingroup HtmlBuilder
+ * @brief   Sinks compressing the generated HTML on the fly with gzip or brotli, before a destination Sink.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Sink.h"
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+// Note: define these to 1 at compile time to use the compressing sinks, linking with zlib (-lz)
+// and with the brotli encoder (-lbrotlienc); by default the library does not depend on them.
+#ifndef HTML_ZLIB
+#define HTML_ZLIB 0
+#endif
+#ifndef HTML_BROTLI
+#define HTML_BROTLI 0
+#endif
+
+#if HTML_ZLIB
+#ifndef ZLIB_CONST
+#define ZLIB_CONST // const input of the z_stream
+#endif
+#include <zlib.h>
+#endif
+#if HTML_BROTLI
+#include <brotli/encode.h>
+#endif
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+#if HTML_ZLIB
+/**
+ * @brief Sink compressing the generated HTML into a gzip stream (Content-Encoding: gzip), written to another Sink.
+ *
+ *   Each chunk is compressed as soon as it is written, so the whole page is never held uncompressed in memory:
+ * only the compressed data are buffered, and sent to the destination each time the buffer is full.
+ * flush() sends everything compressed so far (for instance once the \<head\> is written, for the browser
+ * to start loading the stylesheets), and finish() ends the stream.
+ *
+ * @code
+    HTML::DescriptorSink socketSink(socket);
+    HTML::GzipSink gzip(socketSink);
+    HTML::StreamWriter writer(gzip, HTML::Document("Export"));
+    ... // write the rows
+    writer.finish();
+    gzip.finish();
+ * @endcode
+ *
+ * @warning The stream is truncated unless finish() is called before the destruction of the sink.
+ */
+class GzipSink : public Sink {
+public:
+    static const size_t DefaultBufferSize = 16 * 1024;
+
+    /**
+     * @param[in] aSink         Destination of the compressed data
+     * @param[in] aLevel        Compression level, from 1 (fastest) to 9 (smallest)
+     * @param[in] aBufferSize   Size of the buffer of the compressed data, sent to the destination when full
+     */
+    explicit GzipSink(Sink& aSink, const int aLevel = Z_DEFAULT_COMPRESSION,
+                      const size_t aBufferSize = DefaultBufferSize) :
+        mSink(aSink), mBuffer((aBufferSize > 0) && (aBufferSize <= UINT_MAX) ? aBufferSize : DefaultBufferSize) {
+        mStream.zalloc = Z_NULL;
+        mStream.zfree = Z_NULL;
+        mStream.opaque = Z_NULL;
+        // Note: no pending input, for a flush() or finish() before any write()
+        mStream.next_in = Z_NULL;
+        mStream.avail_in = 0;
+        // Note: 16 added to the size of the window (15 bits, 32KB) writes a gzip header and trailer, not a zlib one
+        if (Z_OK != deflateInit2(&mStream, aLevel, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY)) {
+            throw std::runtime_error("HTML::GzipSink: invalid compression level");
+        }
+        resetOutput();
+    }
+    ~GzipSink() {
+        deflateEnd(&mStream);
+    }
+
+    GzipSink(const GzipSink&) = delete;
+    GzipSink& operator=(const GzipSink&) = delete;
+
+    void write(const char* apData, size_t aSize) override {
+        // Note: the sizes of zlib are unsigned int, so the larger chunks are compressed in parts
+        while (aSize > 0) {
+            const unsigned int size = (aSize < UINT_MAX) ? static_cast<unsigned int>(aSize) : UINT_MAX;
+            mStream.next_in = reinterpret_cast<const Bytef*>(apData);
+            mStream.avail_in = size;
+            compress(Z_NO_FLUSH);
+            apData += size;
+            aSize -= size;
+        }
+    }
+
+    /// Send all the data compressed so far to the destination, at the cost of a slightly lower compression
+    void flush() {
+        if (!mbFinished) {
+            compress(Z_SYNC_FLUSH);
+        }
+        send();
+    }
+
+    /// End the gzip stream, and send it to the destination; the sink cannot be written to anymore
+    void finish() {
+        if (!mbFinished) {
+            compress(Z_FINISH);
+            mbFinished = true;
+        }
+        send();
+    }
+
+private:
+    /// Compress the pending input, emptying the buffer each time it is full
+    void compress(const int aFlush) {
+        if (mbFinished) {
+            throw std::logic_error("HTML::GzipSink: write after finish()");
+        }
+        // Note: deflate() stops either with all the input consumed and the flush complete, or with a full buffer
+        for (;;) {
+            if (Z_STREAM_ERROR == deflate(&mStream, aFlush)) {
+                throw std::runtime_error("HTML::GzipSink: inconsistent zlib stream");
+            }
+            if (mStream.avail_out > 0) {
+                break;
+            }
+            send();
+        }
+    }
+
+    /// Send the compressed data of the buffer to the destination
+    void send() {
+        const size_t size = mBuffer.size() - mStream.avail_out;
+        if (size > 0) {
+            mSink.write(reinterpret_cast<const char*>(mBuffer.data()), size);
+            resetOutput();
+        }
+    }
+    void resetOutput() {
+        mStream.next_out = mBuffer.data();
+        mStream.avail_out = static_cast<unsigned int>(mBuffer.size());
+    }
+
+private:
+    Sink&               mSink;              ///< Destination of the compressed data
+    z_stream            mStream;            ///< State of the compression
+    std::vector<Bytef>  mBuffer;            ///< Compressed data not yet sent to the destination
+    bool                mbFinished = false; ///< The end of the stream has been written
+};
+#endif
+
+#if HTML_BROTLI
+/**
+ * @brief Sink compressing the generated HTML into a brotli stream (Content-Encoding: br), written to another Sink.
+ *
+ *   Like a GzipSink, with a better compression for the same speed at the default quality of 5
+ * (the qualities above 9 are meant for static content, compressed once).
+ *
+ * @warning The stream is truncated unless finish() is called before the destruction of the sink.
+ */
+class BrotliSink : public Sink {
+public:
+    static const int    DefaultQuality = 5;
+    static const size_t DefaultBufferSize = 16 * 1024;
+
+    /**
+     * @param[in] aSink         Destination of the compressed data
+     * @param[in] aQuality      Compression quality, from 0 (fastest) to 11 (smallest)
+     * @param[in] aBufferSize   Size of the buffer of the compressed data, sent to the destination when full
+     */
+    explicit BrotliSink(Sink& aSink, const int aQuality = DefaultQuality,
+                        const size_t aBufferSize = DefaultBufferSize) :
+        mSink(aSink), mpState(BrotliEncoderCreateInstance(nullptr, nullptr, nullptr)),
+        mBuffer((aBufferSize > 0) ? aBufferSize : DefaultBufferSize) {
+        if (!mpState) {
+            throw std::bad_alloc();
+        }
+        if (!BrotliEncoderSetParameter(mpState, BROTLI_PARAM_QUALITY, static_cast<uint32_t>(aQuality)) ||
+            !BrotliEncoderSetParameter(mpState, BROTLI_PARAM_MODE, BROTLI_MODE_TEXT)) {
+            BrotliEncoderDestroyInstance(mpState);
+            throw std::runtime_error("HTML::BrotliSink: invalid compression quality");
+        }
+        resetOutput();
+    }
+    ~BrotliSink() {
+        BrotliEncoderDestroyInstance(mpState);
+    }
+
+    BrotliSink(const BrotliSink&) = delete;
+    BrotliSink& operator=(const BrotliSink&) = delete;
+
+    void write(const char* apData, size_t aSize) override {
+        compress(BROTLI_OPERATION_PROCESS, reinterpret_cast<const uint8_t*>(apData), aSize);
+    }
+
+    /// Send all the data compressed so far to the destination, at the cost of a slightly lower compression
+    void flush() {
+        if (!mbFinished) {
+            compress(BROTLI_OPERATION_FLUSH, nullptr, 0);
+        }
+        send();
+    }
+
+    /// End the brotli stream, and send it to the destination; the sink cannot be written to anymore
+    void finish() {
+        if (!mbFinished) {
+            compress(BROTLI_OPERATION_FINISH, nullptr, 0);
+            mbFinished = true;
+        }
+        send();
+    }
+
+private:
+    /// Compress the input, emptying the buffer each time it is full, until the operation is complete
+    void compress(const BrotliEncoderOperation aOperation, const uint8_t* apData, size_t aSize) {
+        if (mbFinished) {
+            throw std::logic_error("HTML::BrotliSink: write after finish()");
+        }
+        do {
+            if (!BrotliEncoderCompressStream(mpState, aOperation, &aSize, &apData, &mAvailable, &mpNext, nullptr)) {
+                throw std::runtime_error("HTML::BrotliSink: compression failed");
+            }
+            if (0 == mAvailable) {
+                send();
+            }
+        } while ((aSize > 0) || BrotliEncoderHasMoreOutput(mpState));
+    }
+
+    /// Send the compressed data of the buffer to the destination
+    void send() {
+        const size_t size = mBuffer.size() - mAvailable;
+        if (size > 0) {
+            mSink.write(reinterpret_cast<const char*>(mBuffer.data()), size);
+            resetOutput();
+        }
+    }
+    void resetOutput() {
+        mpNext = mBuffer.data();
+        mAvailable = mBuffer.size();
+    }
+
+private:
+    Sink&                   mSink;              ///< Destination of the compressed data
+    BrotliEncoderState*     mpState;            ///< State of the compression
+    std::vector<uint8_t>    mBuffer;            ///< Compressed data not yet sent to the destination
+    uint8_t*                mpNext;             ///< End of the compressed data in the buffer
+    size_t                  mAvailable;         ///< Room left in the buffer
+    bool                    mbFinished = false; ///< The end of the stream has been written
+};
+#endif
+
+} // namespace HTML
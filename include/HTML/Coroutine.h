@@ -0,0 +1,209 @@
+/**
+ * @file    Coroutine.h
+ * @ingroup HtmlBuilder
+ * @brief   Lazy rendering of a Document for C++20 coroutines, awaiting the content of its Deferred Elements.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+// Note: awaiting the chunks and the Deferred Elements requires the coroutines of C++20
+#if !defined(__cpp_impl_coroutine)
+#error "HTML/Coroutine.h requires C++20 coroutines"
+#endif
+
+#include "ChunkedWriter.h"
+#include "Deferred.h"
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Lazy generator of the chunks of a Document, awaited by a coroutine until its Deferred Elements are resolved.
+ *
+ *   Each chunk is generated on demand by a ChunkedWriter walking the tree, so the \<head\> and the beginning
+ * of the \<body\> are sent while the content of the Deferred Elements is still being fetched.
+ *
+ * @code
+    HTML::ChunkStream stream(document);
+    while (std::optional<std::string_view> chunk = co_await stream.next()) {
+        co_await socket.write(*chunk);
+    }
+ * @endcode
+ *
+ * @warning A coroutine awaiting a Deferred is resumed by the thread resolving it, from within Deferred::resolve().
+ */
+class ChunkStream {
+public:
+    /// Awaiter of the next chunk
+    class Awaiter {
+    public:
+        explicit Awaiter(ChunkStream& aStream) : mStream(aStream) {}
+
+        bool await_ready() {
+            return mStream.produce();
+        }
+        bool await_suspend(const std::coroutine_handle<> aHandle) {
+            return mStream.suspend(aHandle);
+        }
+        /// Next chunk, valid until the next call to next(), or std::nullopt at the end of the Document
+        std::optional<std::string_view> await_resume() {
+            return mStream.chunk();
+        }
+
+    private:
+        ChunkStream& mStream;
+    };
+
+    /**
+     * @param[in] aDocument     Document to serialize, starting with its \<!DOCTYPE\>
+     * @param[in] aChunkSize    Size of the chunks, except for the last one and for the ones preceding a Deferred
+     * @param[in] aFormat       Layout of the generated HTML
+     */
+    explicit ChunkStream(const Document& aDocument, const size_t aChunkSize = ChunkedWriter::DefaultChunkSize,
+                         const Format aFormat = Format::Pretty) :
+        mWriter(aDocument, chunkCallback(), aChunkSize, aFormat) {}
+    /// Serialize an Element and its children
+    explicit ChunkStream(const Element& aElement, const size_t aChunkSize = ChunkedWriter::DefaultChunkSize,
+                         const Format aFormat = Format::Pretty) :
+        mWriter(aElement, chunkCallback(), aChunkSize, aFormat) {}
+
+    ChunkStream(const ChunkStream&) = delete;
+    ChunkStream& operator=(const ChunkStream&) = delete;
+
+    /// Await the next chunk, or std::nullopt at the end; rethrow the failure reported to a Deferred
+    Awaiter next() {
+        return Awaiter(*this);
+    }
+
+private:
+    /// Keep each chunk, and pause the writer after it
+    ChunkedWriter::Callback chunkCallback() {
+        return [this](const char* apData, const size_t aSize) {
+            mChunk.assign(apData, aSize);
+            mbChunk = true;
+            return false;
+        };
+    }
+
+    /// Generate the next chunk, unless waiting for a Deferred: return false then
+    bool produce() {
+        mbChunk = false;
+        try {
+            mWriter.resume();
+        } catch (...) {
+            mpError = std::current_exception();
+            return true;
+        }
+        return mbChunk || mWriter.isFinished();
+    }
+
+    /// Wait for the Deferred, unless it gets ready in the meantime: return false to go on without suspending then
+    bool suspend(const std::coroutine_handle<> aHandle) {
+        // Note: the token cancels the call to onReady() if the stream is destroyed before the Deferred is ready
+        while (!(mWait = mWriter.wait([this, aHandle] { onReady(aHandle); }))) {
+            if (produce()) {
+                return false;
+            }
+        }
+        return true;
+    }
+    /// Generate the next chunk once a Deferred is ready, and resume the coroutine, unless waiting for another one
+    void onReady(const std::coroutine_handle<> aHandle) {
+        if (produce() || !suspend(aHandle)) {
+            aHandle.resume();
+        }
+    }
+
+    std::optional<std::string_view> chunk() {
+        if (mpError) {
+            std::rethrow_exception(std::exchange(mpError, nullptr));
+        }
+        if (!mbChunk) {
+            return std::nullopt;
+        }
+        return std::string_view(mChunk);
+    }
+
+private:
+    std::string         mChunk;             ///< Last chunk generated
+    bool                mbChunk = false;    ///< A chunk was generated by the last call to produce()
+    std::exception_ptr  mpError;            ///< Failure to rethrow to the awaiting coroutine
+    ChunkedWriter       mWriter;            ///< Serialization of the Document, paused after each chunk
+    Deferred::WaitToken mWait;              ///< Call to onReady() once the awaited Deferred is ready
+};
+
+/**
+ * @brief Coroutine resolving a Deferred with the result of an awaitable, started right away and never awaited.
+ */
+struct DeferredTask {
+    struct promise_type {
+        DeferredTask get_return_object() noexcept {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept {
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+            std::terminate();
+        }
+    };
+
+    template<typename Awaitable>
+    static DeferredTask resolve(Deferred aDeferred, Awaitable aAwaitable) {
+        std::exception_ptr pError;
+        try {
+            aDeferred.resolve(co_await std::move(aAwaitable));
+        } catch (...) {
+            pError = std::current_exception();
+        }
+        if (pError) {
+            try {
+                aDeferred.fail(std::move(pError));
+            } catch (const std::logic_error&) {
+                // Already resolved by another copy of the Deferred: its content is kept
+            }
+        }
+    }
+};
+
+/**
+ * @brief Deferred Element resolved with the Element produced by an awaitable, like a database query.
+ *
+ *   The awaitable is awaited right away, from a detached coroutine, until its completion resolves the Deferred.
+ *
+ * @code
+    document << HTML::Header1("Report") << HTML::defer(fetchReportTable(database)); // Task<HTML::Table>
+    HTML::ChunkStream stream(document);
+ * @endcode
+ */
+template<typename Awaitable>
+Deferred defer(Awaitable aAwaitable) {
+    Deferred deferred;
+    DeferredTask::resolve(deferred, std::move(aAwaitable));
+    return deferred;
+}
+/// Deferred Element resolved with the Element produced by an awaitable, rendering the placeholder until then
+template<typename Awaitable>
+Deferred defer(Awaitable aAwaitable, Element&& aPlaceholder) {
+    Deferred deferred(std::move(aPlaceholder));
+    DeferredTask::resolve(deferred, std::move(aAwaitable));
+    return deferred;
+}
+
+} // namespace HTML
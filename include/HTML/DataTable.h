@@ -0,0 +1,296 @@
+/**
+ * @file    DataTable.h
+ * @ingroup HtmlBuilder
+ * @brief   Columnar \<table\> rendering its rows straight from column data, without any Element per cell.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Element.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief \<table\> Element storing its data by column, and serializing \<tr\> and \<td\> directly from the values.
+ *
+ *   Each column has a header, its values (or a function generating them at render time) and the attributes
+ * applied to all of its cells, stored once. The values of the numeric columns are stored as numbers,
+ * and formatted at render time into a buffer on the stack (see Number).
+ * The output is identical to the equivalent Table of Row of Col,
+ * with a first Row of ColHeader if any column has a header, and empty Col to complete the shorter columns.
+ *
+ * @code
+    HTML::DataTable table;
+    table.cls("table table-sm");
+    table.addColumn("Name", std::move(names));
+    table.addColumn("Quantity", std::move(quantities));                    // std::vector<long long>
+    table.addColumn("Price", std::move(prices), HTML::FloatFormat::fixed(2)) // std::vector<double>
+        .colStyle("text-align:right");
+    document << std::move(table);
+ * @endcode
+ *
+ * @warning A function generating the values of a column is called at each rendering, including from renderedSize(),
+ *          and concurrently if the Document is serialized in parallel.
+ */
+class DataTable : public Element {
+public:
+    /// Function generating the value of a cell of a column, for the given row
+    typedef std::function<std::string(size_t aRow)> CellFunction;
+
+    DataTable() : Element("table"_name) {}
+
+    /// Add a column, with a header (or an empty string) and its values
+    DataTable&& addColumn(std::string aHeader, std::vector<std::string> aValues) {
+        Column& column = newColumn(std::move(aHeader));
+        column.mValues = std::move(aValues);
+        column.mNbRows = column.mValues.size();
+        attachRows();
+        return std::move(*this);
+    }
+    /// Add a column of integers, with a header (or an empty string)
+    DataTable&& addColumn(std::string aHeader, std::vector<long long> aValues) {
+        Column& column = newColumn(std::move(aHeader));
+        column.mIntegers = std::move(aValues);
+        column.mNbRows = column.mIntegers.size();
+        attachRows();
+        return std::move(*this);
+    }
+    /// Add a column of floating-point numbers, with a header (or an empty string) and their notation and precision
+    DataTable&& addColumn(std::string aHeader, std::vector<double> aValues, const FloatFormat aFormat = FloatFormat()) {
+        Column& column = newColumn(std::move(aHeader));
+        column.mReals = std::move(aValues);
+        column.mFormat = aFormat;
+        column.mNbRows = column.mReals.size();
+        attachRows();
+        return std::move(*this);
+    }
+    /// Add a column, with a header (or an empty string) and a function generating its aNbRows values
+    DataTable&& addColumn(std::string aHeader, const size_t aNbRows, CellFunction aCellFunction) {
+        Column& column = newColumn(std::move(aHeader));
+        column.mCellFunction = std::move(aCellFunction);
+        column.mNbRows = aNbRows;
+        attachRows();
+        return std::move(*this);
+    }
+
+    /// Add an attribute to all the cells of the last column added
+    DataTable&& addColAttribute(const Name& aName, std::string aValue) {
+        if (hasColumns()) {
+            mutableRows().mColumns.back().mAttributes.emplace_back(aName, std::move(aValue));
+        }
+        return std::move(*this);
+    }
+    /// Style of all the cells of the last column added, like Col::style()
+    DataTable&& colStyle(std::string aValue) {
+        return addColAttribute("style"_name, std::move(aValue));
+    }
+    /// Span of all the cells of the last column added, like Col::colSpan()
+    DataTable&& colSpan(const unsigned int aNbCol) {
+        if (0 < aNbCol) {
+            const Number number(aNbCol);
+            addColAttribute("colspan"_name, number.str());
+        }
+        return std::move(*this);
+    }
+
+    /// Remove all the columns, like Element::clear()
+    DataTable&& clear() {
+        Element::clear();
+        mpRows.reset();
+        mRowsIndex = 0;
+        mbRowsAttached = false;
+        return std::move(*this);
+    }
+
+private:
+    struct Column {
+        std::string                 mHeader;        ///< Content of the \<th\> of the column, if any
+        Attributes                  mAttributes;    ///< Attributes of all the \<td\> of the column
+        std::vector<std::string>    mValues;        ///< Values of the column, unless generated by mCellFunction
+        std::vector<long long>      mIntegers;      ///< Values of a column of integers
+        std::vector<double>         mReals;         ///< Values of a column of floating-point numbers
+        FloatFormat                 mFormat;        ///< Notation and precision of the floating-point numbers
+        CellFunction                mCellFunction;  ///< Function generating the values of the column
+        size_t                      mNbRows;        ///< Number of values of the column
+    };
+
+    /// Rows of the table, generated from the columns
+    struct Rows : public Renderable {
+        std::vector<Column> mColumns;
+
+        void render(Writer& aWriter, const size_t aIndentation) const override {
+            WriterOutput output(aWriter);
+            if (hasHeaders()) {
+                writeHeaders(output, aIndentation);
+            }
+            std::string value;
+            const size_t nbDataRows = this->nbDataRows();
+            for (size_t row = 0; row < nbDataRows; ++row) {
+                writeRow(output, row, aIndentation, value);
+            }
+        }
+
+        /// The row of the headers if any, followed by the rows of values
+        size_t nbRows() const override {
+            return (hasHeaders() ? 1 : 0) + nbDataRows();
+        }
+        void renderRow(Writer& aWriter, const size_t aRow, const size_t aIndentation) const override {
+            WriterOutput output(aWriter);
+            if (hasHeaders() && (0 == aRow)) {
+                writeHeaders(output, aIndentation);
+            } else {
+                std::string value;
+                writeRow(output, hasHeaders() ? aRow - 1 : aRow, aIndentation, value);
+            }
+        }
+
+        bool hasHeaders() const {
+            for (const auto& column : mColumns) {
+                if (!column.mHeader.empty()) {
+                    return true;
+                }
+            }
+            return false;
+        }
+        size_t nbDataRows() const {
+            size_t nbDataRows = 0;
+            for (const auto& column : mColumns) {
+                nbDataRows = std::max(nbDataRows, column.mNbRows);
+            }
+            return nbDataRows;
+        }
+
+        void writeHeaders(WriterOutput& aOutput, const size_t aIndentation) const {
+            openRow(aOutput, aIndentation);
+            const Attributes noAttributes;
+            for (const auto& column : mColumns) {
+                writeCell(aOutput, aIndentation + WriterLayout::Indentation, "th", noAttributes,
+                          column.mHeader.data(), column.mHeader.size());
+            }
+            closeRow(aOutput, aIndentation);
+        }
+        /// Row of values, aValue being the buffer of the values generated by a function
+        void writeRow(WriterOutput& aOutput, const size_t aRow, const size_t aIndentation, std::string& aValue) const {
+            openRow(aOutput, aIndentation);
+            const size_t indentation = aIndentation + WriterLayout::Indentation;
+            for (const auto& column : mColumns) {
+                if (aRow >= column.mNbRows) {
+                    writeCell(aOutput, indentation, "td", column.mAttributes, "", 0);
+                } else if (column.mCellFunction) {
+                    aValue = column.mCellFunction(aRow);
+                    writeCell(aOutput, indentation, "td", column.mAttributes, aValue.data(), aValue.size());
+                } else if (!column.mIntegers.empty()) {
+                    const Number number(column.mIntegers[aRow]);
+                    writeCell(aOutput, indentation, "td", column.mAttributes, number.data(), number.size());
+                } else if (!column.mReals.empty()) {
+                    const Number number(column.mReals[aRow], column.mFormat);
+                    writeCell(aOutput, indentation, "td", column.mAttributes, number.data(), number.size());
+                } else {
+                    const std::string& text = column.mValues[aRow];
+                    writeCell(aOutput, indentation, "td", column.mAttributes, text.data(), text.size());
+                }
+            }
+            closeRow(aOutput, aIndentation);
+        }
+
+        /// Same serialization as a Row with children
+        static void openRow(WriterOutput& aOutput, const size_t aIndentation) {
+            WriterLayout::indent(aOutput, aIndentation);
+            append(aOutput, "<tr");
+            WriterLayout::tagEndline(aOutput);
+        }
+        static void closeRow(WriterOutput& aOutput, const size_t aIndentation) {
+            WriterLayout::indent(aOutput, aIndentation);
+            append(aOutput, "</tr");
+            WriterLayout::tagEndline(aOutput);
+        }
+        /// Same serialization as a Col or a ColHeader without children
+        template<size_t N>
+        static void writeCell(WriterOutput& aOutput, const size_t aIndentation, const char (&aTag)[N],
+                              const Attributes& aAttributes, const char* apValue, const size_t aSize) {
+            WriterLayout::indent(aOutput, aIndentation);
+            aOutput += '<';
+            append(aOutput, aTag);
+            for (const auto& attr : aAttributes) {
+                aOutput += ' ';
+                aOutput.append(attr.Name.data(), attr.Name.size());
+                if (!attr.Value.empty()) {
+                    append(aOutput, "=\"");
+                    appendEscaped(aOutput, attr.Value.data(), attr.Value.size());
+                    aOutput += '"';
+                }
+            }
+            aOutput += '>';
+            appendEscaped(aOutput, apValue, aSize);
+            append(aOutput, "</");
+            append(aOutput, aTag);
+            WriterLayout::tagEndline(aOutput);
+        }
+    };
+
+    /// Unnamed child Element rendering the Rows
+    struct RowsElement : public Element {
+        explicit RowsElement(std::shared_ptr<const Rows> apRows) : Element(""_name) {
+            mpRenderable = std::move(apRows);
+        }
+    };
+
+    Column& newColumn(std::string&& aHeader) {
+        Rows& rows = mutableRows();
+        rows.mColumns.push_back(Column{std::move(aHeader), Attributes(), std::vector<std::string>(),
+                                       std::vector<long long>(), std::vector<double>(), FloatFormat(),
+                                       CellFunction(), 0});
+        return rows.mColumns.back();
+    }
+
+    /// Is the child rendering the Rows still there, since Element::clear() may remove it through the base class
+    bool hasRows() const {
+        return mpRows && (mRowsIndex < mChildren.size()) && (mChildren[mRowsIndex].mpRenderable == mpRows);
+    }
+    /// Are there columns, attached as a child or waiting for their first row
+    bool hasColumns() const {
+        return mpRows && (!mbRowsAttached || hasRows()) && !mpRows->mColumns.empty();
+    }
+
+    /// Rows to modify, created with the first column, and copied first if they are shared with a copy of the table
+    Rows& mutableRows() {
+        if (!mpRows || (mbRowsAttached && !hasRows())) {
+            mpRows = std::make_shared<Rows>();
+            mbRowsAttached = false;
+        } else if (mpRows.use_count() > (mbRowsAttached ? 2 : 1)) {
+            mpRows = std::make_shared<Rows>(*mpRows);
+            if (mbRowsAttached) {
+                mChildren[mRowsIndex] = RowsElement(mpRows);
+            }
+        }
+        return *mpRows;
+    }
+
+    /// Add the child rendering the Rows once there is a row to render, so that a table without any row has no child
+    /// and renders like an empty Table
+    void attachRows() {
+        if (!mbRowsAttached && (mpRows->nbRows() > 0)) {
+            mRowsIndex = mChildren.size();
+            mChildren.push_back(RowsElement(mpRows));
+            mbRowsAttached = true;
+        }
+    }
+
+private:
+    std::shared_ptr<Rows>   mpRows;                 ///< Columns of the table, shared with the child rendering them
+    size_t                  mRowsIndex = 0;         ///< Index of this child
+    bool                    mbRowsAttached = false; ///< The Rows are rendered by this child
+};
+
+} // namespace HTML
@@ -0,0 +1,211 @@
+/**
+ * @file    Deferred.h
+ * @ingroup HtmlBuilder
+ * @brief   Placeholder Element whose content is resolved later, while the beginning of the Document is already sent.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Element.h"
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Child Element whose content is only known later, like the result of a database query.
+ *
+ *   The copies of a Deferred share the same content, so the Deferred inserted in a Document is resolved
+ * by calling resolve() (from any thread) on the one kept by the caller. A ChunkedWriter (or a ChunkStream)
+ * sends the HTML preceding the Deferred, then waits for its content to go on; other serializations render
+ * the content if it is already resolved, else the placeholder (nothing by default).
+ *
+ * @code
+    HTML::Deferred rows;
+    document << HTML::Header1("Report") << HTML::Deferred(rows);
+    database.query([rows](Result aResult) mutable { rows.resolve(buildTable(aResult)); });
+ * @endcode
+ */
+class Deferred : public Element {
+public:
+    /// Placeholder rendering nothing until resolved
+    Deferred() : Deferred(std::shared_ptr<const Element>()) {}
+    /// Placeholder rendering the given Element until resolved, like a loading indicator
+    explicit Deferred(Element&& aPlaceholder) : Deferred(std::make_shared<const Element>(std::move(aPlaceholder))) {}
+
+    /**
+     * @brief Provide the content, and wake up the ChunkedWriter waiting for it if any.
+     *
+     * @throw std::logic_error if the Deferred is already resolved
+     */
+    void resolve(Element&& aContent) {
+        mpState->complete(std::make_shared<const Element>(std::move(aContent)), nullptr);
+    }
+    /// Report a failure to produce the content, rethrown by the ChunkedWriter waiting for it
+    void fail(std::exception_ptr apError) {
+        mpState->complete(nullptr, std::move(apError));
+    }
+
+    /// Is the content resolved, or failed
+    bool isReady() const {
+        return mpState->isReady();
+    }
+
+    /// The content shared with the copies cannot be cleared
+    Deferred&& clear() = delete;
+
+private:
+    class State;
+
+public:
+    /**
+     * @brief Registration of a function called once the content of a Deferred is ready (see ChunkedWriter::wait()).
+     *
+     *   Destroying (or reassigning) the token cancels the registration, so the function is never called afterwards,
+     * even if the token is destroyed by another thread while the Deferred is being resolved.
+     */
+    class WaitToken {
+    public:
+        /// Nothing to wait for
+        WaitToken() : mId(0) {}
+        WaitToken(WaitToken&& aOther) noexcept : mpState(std::move(aOther.mpState)), mId(aOther.mId) {}
+        WaitToken& operator=(WaitToken&& aOther) noexcept {
+            WaitToken other(std::move(aOther));
+            std::swap(mpState, other.mpState);
+            std::swap(mId, other.mId);
+            return *this;
+        }
+        ~WaitToken() {
+            if (mpState) {
+                mpState->cancel(mId);
+            }
+        }
+
+        WaitToken(const WaitToken&) = delete;
+        WaitToken& operator=(const WaitToken&) = delete;
+
+        /// Is a function registered, to be called once the content is ready
+        explicit operator bool() const {
+            return static_cast<bool>(mpState);
+        }
+
+    private:
+        friend class State;
+
+        WaitToken(std::shared_ptr<const State>&& apState, const size_t aId) : mpState(std::move(apState)), mId(aId) {}
+
+        std::shared_ptr<const State>    mpState;    ///< Deferred waited for, kept alive until the cancellation
+        size_t                          mId;        ///< Identifier of the registered function
+    };
+
+private:
+    friend class ChunkedWriter;
+
+    /// Content shared by the copies of a Deferred, rendered in place of the Element
+    class State : public Renderable, public std::enable_shared_from_this<State> {
+    public:
+        explicit State(std::shared_ptr<const Element>&& apPlaceholder) : mpPlaceholder(std::move(apPlaceholder)) {}
+
+        void render(Writer& aWriter, const size_t aIndentation) const override {
+            const Element* pElement = isReady() ? mpContent.get() : mpPlaceholder.get();
+            if (pElement) {
+                pElement->renderTo(aWriter, aIndentation);
+            }
+        }
+
+        bool isReady() const {
+            return mbReady.load(std::memory_order_acquire);
+        }
+        /// Content once ready, or nullptr if it failed (see rethrow())
+        const Element* content() const {
+            return mpContent.get();
+        }
+        void rethrow() const {
+            if (mpError) {
+                std::rethrow_exception(mpError);
+            }
+        }
+
+        /// Call aOnReady once the content is ready, unless it already is: return an empty token then, without calling it
+        WaitToken wait(std::function<void()>&& aOnReady) const {
+            std::lock_guard<std::mutex> lock(mMutex);
+            if (isReady()) {
+                return WaitToken();
+            }
+            const size_t id = ++mLastWaiterId;
+            mWaiters.emplace_back(id, std::move(aOnReady));
+            return WaitToken(shared_from_this(), id);
+        }
+        /// Unregister a function, waiting for the end of its call if another thread is running it
+        void cancel(const size_t aId) const {
+            std::lock_guard<std::recursive_mutex> calling(mCallMutex);
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (auto waiter = mWaiters.begin(); waiter != mWaiters.end(); ++waiter) {
+                if (aId == waiter->first) {
+                    mWaiters.erase(waiter);
+                    break;
+                }
+            }
+        }
+
+        void complete(std::shared_ptr<const Element>&& apContent, std::exception_ptr&& apError) {
+            // Note: a waiter may cancel its own registration or the others, like by destroying a ChunkStream
+            std::lock_guard<std::recursive_mutex> calling(mCallMutex);
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                if (isReady()) {
+                    throw std::logic_error("HTML::Deferred already resolved");
+                }
+                mpContent = std::move(apContent);
+                mpError = std::move(apError);
+                mbReady.store(true, std::memory_order_release);
+            }
+            // Wake up the waiters one at a time, without the lock since they go on with the serialization
+            for (;;) {
+                std::function<void()> onReady;
+                {
+                    std::lock_guard<std::mutex> lock(mMutex);
+                    if (mWaiters.empty()) {
+                        break;
+                    }
+                    onReady = std::move(mWaiters.front().second);
+                    mWaiters.erase(mWaiters.begin());
+                }
+                onReady();
+            }
+        }
+
+    private:
+        std::shared_ptr<const Element>              mpPlaceholder;  ///< Rendered until the content is ready
+        std::shared_ptr<const Element>              mpContent;      ///< Content, immutable once ready
+        std::exception_ptr                          mpError;        ///< Failure to produce the content
+        std::atomic<bool>                           mbReady{false}; ///< The content or the error is set
+        mutable std::mutex                          mMutex;         ///< Protect the setting of the content, and mWaiters
+        mutable std::recursive_mutex                mCallMutex;     ///< Held while calling the waiters
+        mutable std::vector<std::pair<size_t, std::function<void()>>> mWaiters; ///< Functions to call once ready
+        mutable size_t                              mLastWaiterId = 0;  ///< Identifier of the last registered one
+    };
+
+    explicit Deferred(std::shared_ptr<const Element>&& apPlaceholder) :
+        Element(""_name), mpState(std::make_shared<State>(std::move(apPlaceholder))) {
+        mpRenderable = mpState;
+        mbDeferred = true;
+    }
+
+private:
+    std::shared_ptr<State> mpState; ///< Content shared with the copies
+};
+
+} // namespace HTML
@@ -0,0 +1,513 @@
+/**
+ * @file    Diff.h
+ * @ingroup HtmlBuilder
+ * @brief   Differences between two versions of an Element tree, as a list of patches to apply to the browser DOM.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Element.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Modification of one element of the browser DOM, addressed by the indices of the element children from the root.
+ *
+ *   The path of the root is empty, and the path of its third child element is [2]: each index is a position
+ * in the Element.children of the DOM, which skips the text, comment and whitespace nodes. The paths address the DOM
+ * as parsed by the browser: the \<tbody\> it inserts around the consecutive rows of a \<table\> is counted,
+ * and the rows generated by a DataTable are distinct rows of this \<tbody\>.
+ */
+struct Patch {
+    enum class Op {
+        Replace,            ///< Replace the node by the HTML of mValue
+        Text,               ///< Set the text of the node (without children) to mValue
+        SetAttribute,       ///< Set the attribute mName of the node to mValue
+        RemoveAttribute,    ///< Remove the attribute mName of the node
+        Insert,             ///< Insert the HTML of mValue as a child of the parent, before the child at the last index
+                            ///< or after the last child
+        Remove              ///< Remove the node
+    };
+
+    Op                  mOp;
+    std::vector<size_t> mPath;  ///< Indices of the children from the root to the node
+    std::string         mName;  ///< Name of the attribute
+    std::string         mValue; ///< HTML (Minified layout), text or attribute value
+};
+
+/**
+ * @brief List of Patch transforming the DOM of an old Element tree into the DOM of a new one.
+ *
+ *   The children are matched by their "id" attribute, and by position for those without id, so that a row
+ * inserted at the top of a Table is a single Insert. Only the differences of the matched Elements with the same name
+ * are recursed into; the other ones are replaced by their HTML. The children shared by the two trees
+ * (like a copy of a template Document, see SharedVector) are skipped without being compared.
+ * The patches are to be applied in order, each path addressing the DOM as modified by the previous ones.
+ *
+ *   Only the element children are addressed: an Element mixing text (or custom content, like a Fragment)
+ * with its child Elements is compared by its HTML, and replaced as a whole when it changed. The Elements are expected
+ * to be valid content of their parent, so that the browser does not move them while parsing the HTML.
+ *
+ * @code
+    HTML::Diff diff(previousTable, table);
+    if (!diff.empty()) {
+        websocket.send(diff.toJson()); // [["t",[0,3,1],"42"],["a",[0,3],"class","alert"],["x",[0,7]]]
+    }
+    previousTable = std::move(table);
+ * @endcode
+ *
+ *   The reference client applying the patches, "root" being the DOM element of the root of the trees:
+ * @code
+    function applyPatches(root, patches) {
+      for (const [op, path, a, b] of patches) {
+        let node = root;
+        for (const idx of (op === 'i') ? path.slice(0, -1) : path) node = node.children[idx];
+        switch (op) {
+          case 'r': node.outerHTML = a; break;
+          case 't': node.textContent = a; break;
+          case 'a': node.setAttribute(a, b); break;
+          case 'd': node.removeAttribute(a); break;
+          case 'i': {
+            const next = node.children[path[path.length - 1]];
+            if (next) next.insertAdjacentHTML('beforebegin', a); else node.insertAdjacentHTML('beforeend', a);
+            break;
+          }
+          case 'x': node.remove(); break;
+        }
+      }
+    }
+ * @endcode
+ */
+class Diff {
+public:
+    Diff(const Element& aOld, const Element& aNew) {
+        std::vector<size_t> path;
+        diff(aOld, aNew, path);
+    }
+
+    const std::vector<Patch>& patches() const {
+        return mPatches;
+    }
+    bool empty() const {
+        return mPatches.empty();
+    }
+
+    /**
+     * @brief Compact JSON array of the patches, each one an array starting with its operation code.
+     *
+     *   ["r", path, html] Replace, ["t", path, text] Text, ["a", path, name, value] SetAttribute,
+     * ["d", path, name] RemoveAttribute, ["i", path, html] Insert and ["x", path] Remove, each path being an array.
+     */
+    std::string toJson() const {
+        static const char* const codes[] = {"[\"r\",[", "[\"t\",[", "[\"a\",[", "[\"d\",[", "[\"i\",[", "[\"x\",["};
+        std::string json;
+        json += '[';
+        for (const Patch& patch : mPatches) {
+            if (json.size() > 1) {
+                json += ',';
+            }
+            json += codes[static_cast<size_t>(patch.mOp)];
+            for (size_t idx = 0; idx < patch.mPath.size(); ++idx) {
+                if (idx > 0) {
+                    json += ',';
+                }
+                const Number index(patch.mPath[idx]);
+                json.append(index.data(), index.size());
+            }
+            json += ']';
+            if ((Patch::Op::SetAttribute == patch.mOp) || (Patch::Op::RemoveAttribute == patch.mOp)) {
+                appendJsonString(json, patch.mName);
+            }
+            if ((Patch::Op::Remove != patch.mOp) && (Patch::Op::RemoveAttribute != patch.mOp)) {
+                appendJsonString(json, patch.mValue);
+            }
+            json += ']';
+        }
+        json += ']';
+        return json;
+    }
+
+private:
+    /// Compare two matched nodes
+    void diff(const Element& aOld, const Element& aNew, std::vector<size_t>& aPath) {
+        if (&aOld == &aNew) {
+            return;
+        }
+        if (aOld.mbShared || aNew.mbShared) {
+            diff(unshared(aOld), unshared(aNew), aPath);
+        } else if (!isSameKind(aOld, aNew)) {
+            add(Patch::Op::Replace, aPath, std::string(), aNew.toString<Minified>());
+        } else if (aOld.mpRenderable || aNew.mpRenderable) {
+            // Note: custom content is compared by its HTML, unless it is the same shared content
+            if (aOld.mpRenderable != aNew.mpRenderable) {
+                std::string html = aNew.toString<Minified>();
+                if (aOld.toString<Minified>() != html) {
+                    add(Patch::Op::Replace, aPath, std::string(), std::move(html));
+                }
+            }
+        } else if (aNew.mName.empty()) {
+            if (aOld.mContent != aNew.mContent) {
+                add(Patch::Op::Replace, aPath, std::string(), aNew.toString<Minified>());
+            }
+        } else if ((aOld.mContent != aNew.mContent) && (!aOld.mChildren.empty() || !aNew.mChildren.empty())) {
+            // Note: the text precedes the children, so it cannot be set without them
+            add(Patch::Op::Replace, aPath, std::string(), aNew.toString<Minified>());
+        } else if ((aOld.mChildren.begin() == aNew.mChildren.begin()) || (isElementOnly(aOld) && isElementOnly(aNew))) {
+            diffElement(aOld, aNew, aPath);
+            if (aOld.mChildren.begin() != aNew.mChildren.begin()) {
+                diffChildren(aOld.mChildren, aNew.mChildren, aPath);
+            }
+        } else {
+            const Nodes oldNodes(aOld);
+            const Nodes newNodes(aNew);
+            if (oldNodes.mbOpaque || newNodes.mbOpaque) {
+                replaceChanged(aOld, aNew, aPath);
+            } else {
+                diffElement(aOld, aNew, aPath);
+                diffChildren(NodeRange(oldNodes.mNodes), NodeRange(newNodes.mNodes), aPath);
+            }
+        }
+    }
+
+    /// Compare the attributes and the text of two Elements of the same kind
+    void diffElement(const Element& aOld, const Element& aNew, const std::vector<size_t>& aPath) {
+        diffAttributes(aOld, aNew, aPath);
+        if (aOld.mContent != aNew.mContent) {
+            add(Patch::Op::Text, aPath, std::string(), aNew.mContent);
+        }
+    }
+
+    /// Replace the node if its HTML changed
+    template<typename Node>
+    void replaceChanged(const Node& aOld, const Node& aNew, const std::vector<size_t>& aPath) {
+        std::string html = toHtml(aNew);
+        if (toHtml(aOld) != html) {
+            add(Patch::Op::Replace, aPath, std::string(), std::move(html));
+        }
+    }
+
+    /// Subtree rendered in place of a Shared
+    static const Element& unshared(const Element& aElement) {
+        return aElement.mbShared ? static_cast<const Shared::Content&>(*aElement.mpRenderable).mElement : aElement;
+    }
+
+    /// Are the children the element children of the DOM: no text nor custom content, and no \<tbody\> inserted
+    static bool isElementOnly(const Element& aParent) {
+        if (aParent.mName == "table"_name) {
+            return false;
+        }
+        for (size_t idx = 0; idx < aParent.mChildren.size(); ++idx) {
+            const Element& child = aParent.mChildren[idx];
+            if (child.mName.empty() || child.mpRenderable) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Element child of the DOM
+    struct Node {
+        enum class Kind {
+            Element,    ///< Named Element
+            Row,        ///< Row of a custom content made of \<tr\> rows, like the rows of a DataTable
+            Body        ///< \<tbody\> inserted by the browser around consecutive rows of a \<table\>
+        };
+
+        Kind            mKind;
+        const Element*  mpElement;  ///< Element, or Element of the custom content of a Row
+        size_t          mRow;       ///< Index of a Row in its custom content, or of the first row of a Body
+        size_t          mEnd;       ///< End of the rows of a Body
+        const Node*     mpRows;     ///< Rows of a Body
+    };
+
+    /// Element children of the DOM of an Element, as parsed by the browser
+    struct Nodes {
+        explicit Nodes(const Element& aParent) : mbTable(aParent.mName == "table"_name) {
+            for (size_t idx = 0; idx < aParent.mChildren.size(); ++idx) {
+                add(aParent.mChildren[idx]);
+            }
+            for (Node& node : mNodes) {
+                node.mpRows = mRows.data();
+            }
+        }
+        Nodes(const Nodes&) = delete;
+        Nodes& operator=(const Nodes&) = delete;
+
+        void add(const Element& aChild) {
+            if (aChild.mbShared) {
+                add(unshared(aChild));
+            } else if (aChild.mpRenderable) {
+                const size_t nbRows = aChild.mpRenderable->nbRows();
+                if (Renderable::NotRows == nbRows) {
+                    mbOpaque = true;
+                }
+                for (size_t row = 0; (row < nbRows) && !mbOpaque; ++row) {
+                    add(Node{Node::Kind::Row, &aChild, row, 0, nullptr});
+                }
+            } else if (!aChild.mName.empty()) {
+                add(Node{Node::Kind::Element, &aChild, 0, 0, nullptr});
+            } else if (aChild.mbRaw || !aChild.mContent.empty() || !aChild.mChildren.empty()) {
+                mbOpaque = true;
+            }
+        }
+        void add(const Node& aNode) {
+            const bool bRow = (Node::Kind::Row == aNode.mKind) || (aNode.mpElement->mName == "tr"_name);
+            if (!mbTable || !bRow) {
+                mNodes.push_back(aNode);
+                return;
+            }
+            // Note: like the browser, the consecutive rows of a table are grouped in the same body
+            if (mNodes.empty() || (Node::Kind::Body != mNodes.back().mKind)) {
+                mNodes.push_back(Node{Node::Kind::Body, nullptr, mRows.size(), mRows.size(), nullptr});
+            }
+            mRows.push_back(aNode);
+            mNodes.back().mEnd = mRows.size();
+        }
+
+        const bool          mbTable;            ///< The rows of a table are in a body
+        bool                mbOpaque = false;   ///< Text or custom content among the children
+        std::vector<Node>   mNodes;             ///< Element children
+        std::vector<Node>   mRows;              ///< Rows of the Body children
+    };
+
+    /// Element children, matched like the Children of an Element
+    class NodeRange {
+    public:
+        explicit NodeRange(const std::vector<Node>& aNodes) : mpBegin(aNodes.data()), mSize(aNodes.size()) {}
+        /// Rows of a Body
+        explicit NodeRange(const Node& aBody) : mpBegin(aBody.mpRows + aBody.mRow), mSize(aBody.mEnd - aBody.mRow) {}
+
+        size_t size() const {
+            return mSize;
+        }
+        const Node& operator[](const size_t aIndex) const {
+            return mpBegin[aIndex];
+        }
+
+    private:
+        const Node* mpBegin;
+        size_t      mSize;
+    };
+
+    /// Compare two matched Element children of the DOM
+    void diff(const Node& aOld, const Node& aNew, std::vector<size_t>& aPath) {
+        if ((Node::Kind::Element == aOld.mKind) && (Node::Kind::Element == aNew.mKind)) {
+            diff(*aOld.mpElement, *aNew.mpElement, aPath);
+        } else if ((Node::Kind::Body == aOld.mKind) && (Node::Kind::Body == aNew.mKind)) {
+            diffChildren(NodeRange(aOld), NodeRange(aNew), aPath);
+        } else if ((Node::Kind::Row != aOld.mKind) || (Node::Kind::Row != aNew.mKind) ||
+                   (aOld.mpElement->mpRenderable != aNew.mpElement->mpRenderable) || (aOld.mRow != aNew.mRow)) {
+            // Note: a row is compared by its HTML, unless it is the same row of the same shared content
+            replaceChanged(aOld, aNew, aPath);
+        }
+    }
+
+    static std::string toHtml(const Element& aElement) {
+        return aElement.toString<Minified>();
+    }
+    static std::string toHtml(const Node& aNode) {
+        if (Node::Kind::Element == aNode.mKind) {
+            return aNode.mpElement->toString<Minified>();
+        }
+        std::string html;
+        if (Node::Kind::Row == aNode.mKind) {
+            OutputWriter<Minified, std::string> writer(html);
+            aNode.mpElement->mpRenderable->renderRow(writer, aNode.mRow, 0);
+        } else {
+            const NodeRange rows(aNode);
+            html += "<tbody>";
+            for (size_t idx = 0; idx < rows.size(); ++idx) {
+                html += toHtml(rows[idx]);
+            }
+            html += "</tbody>";
+        }
+        return html;
+    }
+
+    static const std::string* findId(const Element& aElement) {
+        return findAttribute(aElement, "id"_name);
+    }
+    static const std::string* findId(const Node& aNode) {
+        return (Node::Kind::Element == aNode.mKind) ? findAttribute(*aNode.mpElement, "id"_name) : nullptr;
+    }
+
+    /// Can the node be modified in place, instead of replaced
+    static bool isSameKind(const Element& aOld, const Element& aNew) {
+        return (aOld.mName == aNew.mName) && (aOld.mbVoid == aNew.mbVoid) && (aOld.mbRaw == aNew.mbRaw) &&
+               (!aOld.mpRenderable == !aNew.mpRenderable);
+    }
+
+    void diffAttributes(const Element& aOld, const Element& aNew, const std::vector<size_t>& aPath) {
+        for (const auto& attr : aOld.mAttributes) {
+            if (!findAttribute(aNew, attr.Name)) {
+                add(Patch::Op::RemoveAttribute, aPath, std::string(attr.Name.data(), attr.Name.size()), std::string());
+            }
+        }
+        for (const auto& attr : aNew.mAttributes) {
+            const std::string* pOldValue = findAttribute(aOld, attr.Name);
+            if (!pOldValue || (*pOldValue != attr.Value)) {
+                add(Patch::Op::SetAttribute, aPath, std::string(attr.Name.data(), attr.Name.size()), attr.Value);
+            }
+        }
+    }
+
+    /// Match the children by id, or else by position, then remove, insert or compare them in the order of the new ones
+    template<typename Children>
+    void diffChildren(const Children& aOldChildren, const Children& aNewChildren, std::vector<size_t>& aPath) {
+        static const size_t None = static_cast<size_t>(-1);
+
+        if (!hasId(aOldChildren) && !hasId(aNewChildren)) {
+            diffPositions(aOldChildren, aNewChildren, aPath);
+            return;
+        }
+
+        std::unordered_map<std::string, size_t> oldIds;
+        for (size_t idx = 0; idx < aOldChildren.size(); ++idx) {
+            const std::string* pId = findId(aOldChildren[idx]);
+            if (pId) {
+                oldIds.emplace(*pId, idx);
+            }
+        }
+        std::vector<size_t> matches(aNewChildren.size(), None);
+        std::vector<bool> bMatched(aOldChildren.size(), false);
+        size_t nextOld = 0; // next old child without id, to match by position
+        for (size_t idx = 0; idx < aNewChildren.size(); ++idx) {
+            const std::string* pId = findId(aNewChildren[idx]);
+            if (pId) {
+                const auto found = oldIds.find(*pId);
+                if ((found != oldIds.end()) && !bMatched[found->second]) {
+                    matches[idx] = found->second;
+                    bMatched[found->second] = true;
+                }
+            } else {
+                while ((nextOld < aOldChildren.size()) && findId(aOldChildren[nextOld])) {
+                    ++nextOld;
+                }
+                if (nextOld < aOldChildren.size()) {
+                    matches[idx] = nextOld;
+                    bMatched[nextOld++] = true;
+                }
+            }
+        }
+
+        // Remove the old children without match, from the last one so that the indices stay valid
+        std::vector<size_t> current; // old child at each position of the DOM being patched, or None once inserted
+        for (size_t idx = aOldChildren.size(); idx-- > 0;) {
+            if (!bMatched[idx]) {
+                aPath.push_back(idx);
+                add(Patch::Op::Remove, aPath, std::string(), std::string());
+                aPath.pop_back();
+            }
+        }
+        for (size_t idx = 0; idx < aOldChildren.size(); ++idx) {
+            if (bMatched[idx]) {
+                current.push_back(idx);
+            }
+        }
+
+        for (size_t idx = 0; idx < aNewChildren.size(); ++idx) {
+            aPath.push_back(idx);
+            if (None == matches[idx]) {
+                add(Patch::Op::Insert, aPath, std::string(), toHtml(aNewChildren[idx]));
+                current.insert(current.begin() + static_cast<std::ptrdiff_t>(idx), None);
+            } else if (current[idx] == matches[idx]) {
+                diff(aOldChildren[matches[idx]], aNewChildren[idx], aPath);
+            } else {
+                // Note: a child moved before other ones is removed and inserted again, to keep the patches simple
+                size_t position = idx + 1;
+                while (current[position] != matches[idx]) {
+                    ++position;
+                }
+                aPath.back() = position;
+                add(Patch::Op::Remove, aPath, std::string(), std::string());
+                aPath.back() = idx;
+                add(Patch::Op::Insert, aPath, std::string(), toHtml(aNewChildren[idx]));
+                current.erase(current.begin() + static_cast<std::ptrdiff_t>(position));
+                current.insert(current.begin() + static_cast<std::ptrdiff_t>(idx), None);
+            }
+            aPath.pop_back();
+        }
+    }
+
+    /// Match the children by position only, without any allocation: the common case of the cells of a table
+    template<typename Children>
+    void diffPositions(const Children& aOldChildren, const Children& aNewChildren, std::vector<size_t>& aPath) {
+        const size_t common = std::min(aOldChildren.size(), aNewChildren.size());
+        for (size_t idx = aOldChildren.size(); idx-- > common;) {
+            aPath.push_back(idx);
+            add(Patch::Op::Remove, aPath, std::string(), std::string());
+            aPath.pop_back();
+        }
+        for (size_t idx = 0; idx < aNewChildren.size(); ++idx) {
+            aPath.push_back(idx);
+            if (idx < common) {
+                diff(aOldChildren[idx], aNewChildren[idx], aPath);
+            } else {
+                add(Patch::Op::Insert, aPath, std::string(), toHtml(aNewChildren[idx]));
+            }
+            aPath.pop_back();
+        }
+    }
+
+    template<typename Children>
+    static bool hasId(const Children& aChildren) {
+        for (size_t idx = 0; idx < aChildren.size(); ++idx) {
+            if (findId(aChildren[idx])) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    static const std::string* findAttribute(const Element& aElement, const Name& aName) {
+        for (const auto& attr : aElement.mAttributes) {
+            if (attr.Name == aName) {
+                return &attr.Value;
+            }
+        }
+        return nullptr;
+    }
+
+    void add(const Patch::Op aOp, const std::vector<size_t>& aPath, std::string&& aName, std::string&& aValue) {
+        mPatches.push_back(Patch{aOp, aPath, std::move(aName), std::move(aValue)});
+    }
+    void add(const Patch::Op aOp, const std::vector<size_t>& aPath, std::string&& aName, const std::string& aValue) {
+        mPatches.push_back(Patch{aOp, aPath, std::move(aName), aValue});
+    }
+
+    /// Append a JSON string, after a comma
+    static void appendJsonString(std::string& aJson, const std::string& aString) {
+        aJson += ",\"";
+        for (const char c : aString) {
+            if (('"' == c) || ('\\' == c)) {
+                aJson += '\\';
+                aJson += c;
+            } else if ('\n' == c) {
+                aJson += "\\n";
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(c));
+                aJson += escaped;
+            } else {
+                aJson += c;
+            }
+        }
+        aJson += '"';
+    }
+
+private:
+    std::vector<Patch> mPatches; ///< Patches, in the order to apply them
+};
+
+} // namespace HTML
@@ -11,94 +11,368 @@
 #pragma once
 
 #include "Element.h"
+#include "Head.h"
 
-#include <sstream>
+#include <algorithm>
+#include <memory>
+#include <ostream>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 /// A simple C++ HTML Generator library.
 namespace HTML {
 
-// Note: to configure indentation & minification, define this at compile time before including HTML headers.
-#ifndef HTML_INDENTATION
-#define HTML_INDENTATION 2
-#endif
-#ifndef HTML_ENDLINE
-#define HTML_ENDLINE "\n"
-#endif
-
 /**
  * @brief Root Element \<html\> of the HTML Document Object Model.
  *
  *   The Document is a specialized Element with restriction on what can be done on it,
  * since many aspects of the \<html\> root tag are well defined and constrained.
+ *
+ *   A Document is cheap to copy and to move: the copies share their subtrees until modified (see SharedVector),
+ * so a template Document can be cloned for each request at the cost of the Elements modified afterward.
+ *
+ *   The Elements can be looked up by id and by class after the Document is built (getElementById()),
+ * to amend them without keeping references to them while building it.
+ *
+ * @warning The Elements returned by head() and body() must not be kept across a copy of the Document.
  */
 class Document : public Element {
 public:
-    Document() :
-        Element(), mHead(*static_cast<Head*>(&mChildren[0])), mBody(*static_cast<Body*>(&mChildren[1])) {
-    }
-    explicit Document(const char* apTitle) :
-        Element(), mHead(*static_cast<Head*>(&mChildren[0])), mBody(*static_cast<Body*>(&mChildren[1])) {
-        mHead << HTML::Title(apTitle);
+    Document() : Element() {}
+    explicit Document(const char* apTitle) : Element() {
+        headElement() << HTML::Title(apTitle);
     }
-    explicit Document(const std::string& aTitle) :
-        Element(), mHead(*static_cast<Head*>(&mChildren[0])), mBody(*static_cast<Body*>(&mChildren[1])) {
-        mHead << HTML::Title(aTitle);
+    explicit Document(const std::string& aTitle) : Element() {
+        headElement() << HTML::Title(aTitle);
     }
-    Document(const char* apTitle, Style&& aStyle) :
-        Element(), mHead(*static_cast<Head*>(&mChildren[0])), mBody(*static_cast<Body*>(&mChildren[1])) {
-        mHead << HTML::Title(apTitle);
-        mHead << std::move(aStyle);
+    Document(const char* apTitle, Style&& aStyle) : Element() {
+        headElement() << HTML::Title(apTitle);
+        headElement() << std::move(aStyle);
     }
-    Document(const char* apTitle, const Style& aStyle) :
-        Element(), mHead(*static_cast<Head*>(&mChildren[0])), mBody(*static_cast<Body*>(&mChildren[1])) {
-        mHead << HTML::Title(apTitle);
-        mHead << Style(aStyle);
+    Document(const char* apTitle, const Style& aStyle) : Element() {
+        headElement() << HTML::Title(apTitle);
+        headElement() << Style(aStyle);
     }
 
+    /// Append an Element to the \<body\>, adding its ids and classes to the index if the Document is indexed
     Document& operator<<(Element&& aElement) {
-        mBody << std::move(aElement);
+        Element& bodyElement = mChildren[1];
+        bodyElement << std::move(aElement);
+        if (mpIndex && (1 == mpIndex.use_count())) {
+            const Children& children = bodyElement.mChildren;
+            std::vector<size_t> path{1, children.size() - 1};
+            indexElement(*mpIndex, children.back(), path);
+        } else {
+            mpIndex.reset(); // shared with a copy of the Document
+        }
         return *this;
     }
 
+    /// The \<head\>, first child of the Document, unshared from the copies of the Document first
     Element& head() {
-        return mHead;
+        mpIndex.reset();
+        return mChildren[0];
+    }
+    const Element& head() const {
+        return mChildren[0];
     }
+    /// The \<body\>, second child of the Document, unshared from the copies of the Document first
     Element& body() {
-        return mBody;
+        mpIndex.reset();
+        return mChildren[1];
+    }
+    const Element& body() const {
+        return mChildren[1];
+    }
+
+    /**
+     * @brief Remove the whole content of the Document, keeping its \<head\> with its \<title\>, its \<body\>,
+     *        and the memory of their lists.
+     *
+     *   The Document is then rebuilt for the next request without reallocating the lists of children
+     * of the \<head\> and of the \<body\>, nor the attributes of the three Elements (see also PooledDocument).
+     */
+    Document& reset() {
+        mAttributes.clear();
+        Element& headElement = head();
+        Element title(""_name);
+        for (size_t idx = 0; idx < headElement.mChildren.size(); ++idx) {
+            if ("title"_name == headElement.mChildren[idx].mName) {
+                title = std::move(headElement.mChildren[idx]);
+                break;
+            }
+        }
+        headElement.clear();
+        if (!title.mName.empty()) {
+            headElement.mChildren.push_back(std::move(title));
+        }
+        body().clear();
+        return *this;
+    }
+
+    /// The \<head\> and \<body\> of a Document cannot be removed: use reset()
+    Document& clear() = delete;
+
+    /**
+     * @brief First Element of the Document (in the order of the HTML) with the given id, or nullptr if none.
+     *
+     *   The first lookup indexes the ids and classes of all the Elements in a single walk of the tree, then each
+     * lookup is a hash of the id followed by the few indices leading to the Element. The Elements appended
+     * with operator<< are indexed as they come, and the index is built again after any modification through head(),
+     * body() or reset(). The Element found can be modified: it is first unshared from the copies of the Document.
+     *
+     * @code
+        document.getElementById("anchor_link_1")->addAttribute("class", "active") << HTML::Text("New");
+     * @endcode
+     *
+     * @warning The children added under the Elements found, and the changes of their id or class, are only indexed
+     *          after reindex(): until then, an Element moved or renamed is not found. The Elements found must not be
+     *          kept across another lookup or a copy of the Document.
+     */
+    Element* getElementById(const std::string& aId) {
+        const Index& knownIndex = index();
+        const auto found = knownIndex.mIds.find(aId);
+        return (found != knownIndex.mIds.end()) ? resolve(found->second, "id"_name, aId) : nullptr;
+    }
+
+    /// All the Elements of the Document (in the order of the HTML) having the given class, see getElementById()
+    std::vector<Element*> getElementsByClass(const std::string& aClass) {
+        std::vector<Element*> elements;
+        const Index& knownIndex = index();
+        const auto found = knownIndex.mClasses.find(aClass);
+        if (found != knownIndex.mClasses.end()) {
+            elements.reserve(found->second.size());
+            for (const size_t offset : found->second) {
+                if (Element* pElement = resolve(offset, "class"_name, aClass)) {
+                    elements.push_back(pElement);
+                }
+            }
+        }
+        return elements;
+    }
+
+    /// Drop the index of the ids and classes, to build it again at the next lookup
+    void reindex() {
+        mpIndex.reset();
     }
 
     void lang(const char* apLang) {
-        mHead.addAttribute("lang", apLang);
+        head().addAttribute("lang"_name, apLang);
     }
 
     friend std::ostream& operator<< (std::ostream& aStream, const Document& aElement);
 
+    /// Serialize the whole Document, with the Pretty layout by default, or the Minified one
+    template<typename Layout = Pretty>
     std::string toString() const {
-        std::ostringstream stream;
-        stream << *this;
-        return stream.str();
+        std::string buffer;
+        buffer.reserve(renderedSize<Layout>());
+        appendTo<Layout>(buffer);
+        return buffer;
+    }
+    /// Serialize the whole Document, with a layout selected at runtime
+    std::string toString(const Format aFormat) const {
+        return (Format::Minified == aFormat) ? toString<Minified>() : toString<Pretty>();
     }
 
     operator std::string() const {
         return toString();
     }
 
+    /**
+     * @brief Serialize the whole Document, starting with its \<!DOCTYPE\>, at the end of a caller-owned buffer.
+     *
+     * @tparam        Layout    Layout policy, Pretty or Minified
+     * @param[in,out] aBuffer   Buffer to append the generated HTML to, or any Output like a VectoredOutput
+     *
+     * @return the buffer, to chain calls
+     */
+    template<typename Layout = Pretty, typename Output>
+    Output& appendTo(Output& aBuffer) const {
+        render<Layout>(aBuffer);
+        return aBuffer;
+    }
+    template<typename Output>
+    Output& appendTo(Output& aBuffer, const Format aFormat) const {
+        return (Format::Minified == aFormat) ? appendTo<Minified>(aBuffer) : appendTo<Pretty>(aBuffer);
+    }
+
+    /// Serialize the whole Document, the large lists of children being serialized in parallel (see ParallelPolicy)
+    std::string toString(const ParallelPolicy& aPolicy) const {
+        std::string buffer;
+        appendTo(buffer, aPolicy);
+        return buffer;
+    }
+
+    /// Serialize the whole Document at the end of a caller-owned buffer, the large lists of children in parallel
+    std::string& appendTo(std::string& aBuffer, const ParallelPolicy& aPolicy) const {
+        if (Format::Minified == aPolicy.mFormat) {
+            append(aBuffer, "<!DOCTYPE html>");
+            Element::render<Minified>(aBuffer, 0, aPolicy);
+        } else {
+            append(aBuffer, "<!DOCTYPE html>");
+            Pretty::endline(aBuffer);
+            Element::render<Pretty>(aBuffer, 0, aPolicy);
+        }
+        return aBuffer;
+    }
+
+    /// Compute the exact number of characters that appendTo() would generate, \<!DOCTYPE\> included.
+    template<typename Layout = Pretty>
+    size_t renderedSize() const {
+        SizeCounter counter;
+        render<Layout>(counter);
+        return counter.size();
+    }
+    size_t renderedSize(const Format aFormat) const {
+        return (Format::Minified == aFormat) ? renderedSize<Minified>() : renderedSize<Pretty>();
+    }
+
+    /// Compute the statistics of the serialization like Element::renderStats(), \<!DOCTYPE\> included.
+    template<typename Layout = Pretty>
+    RenderStats renderStats() const {
+        SizeCounter counter;
+        append(counter, "<!DOCTYPE html>");
+        Layout::endline(counter);
+        RenderStats stats = Element::renderStats<Layout>();
+        stats.mBytesPerTag["!DOCTYPE"] += counter.size();
+        stats.mBytes += counter.size();
+        return stats;
+    }
+    RenderStats renderStats(const Format aFormat) const {
+        return (Format::Minified == aFormat) ? renderStats<Minified>() : renderStats<Pretty>();
+    }
+
 private:
-    std::ostream& toString(std::ostream& aStream) const {
-        aStream << "<!DOCTYPE html>" HTML_ENDLINE;
-        Element::toString(aStream);
-        return aStream;
+    friend class StreamWriter;
+
+    template<typename Layout, typename Output>
+    void render(Output& aBuffer) const {
+        append(aBuffer, "<!DOCTYPE html>");
+        Layout::endline(aBuffer);
+        Element::render<Layout>(aBuffer, 0);
+    }
+
+    /// The \<head\> with its restricted interface
+    Head& headElement() {
+        return static_cast<Head&>(head());
+    }
+
+    /// Path of each Element with an id or a class, stored in mPaths as its length followed by the indices of children
+    struct Index {
+        std::vector<size_t>                                     mPaths;     ///< Paths from the \<html\> root
+        std::unordered_map<std::string, size_t>                 mIds;       ///< Path of the first Element of each id
+        std::unordered_map<std::string, std::vector<size_t>>    mClasses;   ///< Paths of the Elements of each class
+    };
+
+    /// Index of the Document, built at the first lookup
+    const Index& index() {
+        if (!mpIndex) {
+            mpIndex = std::make_shared<Index>();
+            std::vector<size_t> path;
+            indexElement(*mpIndex, *this, path);
+        }
+        return *mpIndex;
+    }
+
+    /// Index the id and the classes of an Element and of its children
+    static void indexElement(Index& aIndex, const Element& aElement, std::vector<size_t>& aPath) {
+        const std::string* pId = nullptr;
+        const std::string* pClasses = nullptr;
+        for (const auto& attr : aElement.mAttributes) {
+            if (!pId && (attr.Name == "id"_name)) {
+                pId = &attr.Value;
+            } else if (!pClasses && (attr.Name == "class"_name)) {
+                pClasses = &attr.Value;
+            }
+        }
+        if (pId || pClasses) {
+            const size_t offset = aIndex.mPaths.size();
+            aIndex.mPaths.push_back(aPath.size());
+            aIndex.mPaths.insert(aIndex.mPaths.end(), aPath.begin(), aPath.end());
+            if (pId) {
+                aIndex.mIds.emplace(*pId, offset);
+            }
+            if (pClasses) {
+                indexClasses(aIndex, *pClasses, offset);
+            }
+        }
+        for (size_t idx = 0; idx < aElement.mChildren.size(); ++idx) {
+            aPath.push_back(idx);
+            indexElement(aIndex, aElement.mChildren[idx], aPath);
+            aPath.pop_back();
+        }
+    }
+
+    /// Index each of the classes separated by spaces, like "nav-item active"
+    static void indexClasses(Index& aIndex, const std::string& aClasses, const size_t aOffset) {
+        static const char* const spaces = " \t\n\f\r";
+        for (size_t begin = aClasses.find_first_not_of(spaces); begin != std::string::npos;) {
+            const size_t end = std::min(aClasses.find_first_of(spaces, begin), aClasses.size());
+            std::vector<size_t>& offsets = aIndex.mClasses[aClasses.substr(begin, end - begin)];
+            if (offsets.empty() || (offsets.back() != aOffset)) {
+                offsets.push_back(aOffset);
+            }
+            begin = aClasses.find_first_not_of(spaces, end);
+        }
+    }
+
+    /**
+     * @brief Element at the path stored at the given offset, unshared from the copies of the Document,
+     *        or nullptr if the path is outdated: no Element there, or one without the id or the class looked up.
+     */
+    Element* resolve(const size_t aOffset, const Name& aAttribute, const std::string& aValue) {
+        const std::vector<size_t>& paths = mpIndex->mPaths;
+        const Element* pElement = this;
+        for (size_t idx = aOffset + 1; idx <= aOffset + paths[aOffset]; ++idx) {
+            if (paths[idx] >= pElement->mChildren.size()) {
+                return nullptr;
+            }
+            pElement = &pElement->mChildren[paths[idx]];
+        }
+        if (!carries(*pElement, aAttribute, aValue)) {
+            return nullptr;
+        }
+        // Note: the path is walked again through the mutable children only once checked, to unshare them
+        Element* pFound = this;
+        for (size_t idx = aOffset + 1; idx <= aOffset + paths[aOffset]; ++idx) {
+            pFound = &pFound->mChildren[paths[idx]];
+        }
+        return pFound;
+    }
+
+    /// Has the Element the given id, or the given class among the ones separated by spaces
+    static bool carries(const Element& aElement, const Name& aAttribute, const std::string& aValue) {
+        static const char* const spaces = " \t\n\f\r";
+        for (const auto& attr : aElement.mAttributes) {
+            if (attr.Name == aAttribute) {
+                if ("class"_name != aAttribute) {
+                    return attr.Value == aValue;
+                }
+                const std::string& classes = attr.Value;
+                for (size_t begin = classes.find_first_not_of(spaces); begin != std::string::npos;) {
+                    const size_t end = std::min(classes.find_first_of(spaces, begin), classes.size());
+                    if (0 == classes.compare(begin, end - begin, aValue)) {
+                        return true;
+                    }
+                    begin = classes.find_first_not_of(spaces, end);
+                }
+                return false;
+            }
+        }
+        return false;
     }
 
 private:
-    Head& mHead; ///< Reference to the first child Element \<head\>
-    Body& mBody; ///< Reference to the second child Element \<body\>
+    // Note: the index is shared by the copies of the Document, and only extended in place while it is not shared
+    std::shared_ptr<Index> mpIndex; ///< Index of the ids and classes of the Elements, built at the first lookup
 };
 
 inline std::ostream& operator<< (std::ostream& aStream, const Document& aDocument) {
-    return aDocument.toString(aStream);
+    const std::string buffer = aDocument.toString();
+    return aStream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
 }
 
 } // namespace HTML
@@ -0,0 +1,162 @@
+/**
+ * @file    DocumentPool.h
+ * @ingroup HtmlBuilder
+ * @brief   Pool of arenas recycled between the Documents built by a thread, without any allocation once warmed up.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Allocator.h"
+#include "Document.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Arenas kept between the Documents built by a thread, so each page reuses the memory of the previous one.
+ *
+ *   An arena handed to a PooledDocument comes back to the pool with the Document, and is reset (see
+ * MonotonicArena::reset()) for the next one: after the first similar pages, building a page costs no allocation
+ * from the global heap (the long strings excepted), so the threads of a server do not contend on the allocator.
+ *
+ * @warning A pool is not thread-safe: each thread uses its own, local() by default.
+ */
+class DocumentPool {
+public:
+    static const size_t DefaultBlockSize = 64 * 1024;
+    static const size_t DefaultMaxArenas = 4;
+
+    /**
+     * @param[in] aBlockSize    Size of the first block of the new arenas
+     * @param[in] aMaxArenas    Number of arenas kept, for the PooledDocuments of the thread alive at the same time
+     */
+    explicit DocumentPool(const size_t aBlockSize = DefaultBlockSize, const size_t aMaxArenas = DefaultMaxArenas) :
+        mBlockSize(aBlockSize), mMaxArenas(aMaxArenas) {}
+
+    DocumentPool(const DocumentPool&) = delete;
+    DocumentPool& operator=(const DocumentPool&) = delete;
+
+    /// Pool of the calling thread
+    static DocumentPool& local() {
+        static thread_local DocumentPool pool;
+        return pool;
+    }
+
+    /// Number of arenas ready for the next PooledDocuments
+    size_t available() const {
+        return mArenas.size();
+    }
+    /// Total size of the memory kept by the arenas ready
+    size_t allocated() const {
+        size_t size = 0;
+        for (const auto& pArena : mArenas) {
+            size += pArena->allocated();
+        }
+        return size;
+    }
+
+private:
+    friend class PooledDocument;
+
+    std::unique_ptr<MonotonicArena> acquire() {
+        if (mArenas.empty()) {
+            return std::unique_ptr<MonotonicArena>(new MonotonicArena(mBlockSize));
+        }
+        std::unique_ptr<MonotonicArena> pArena = std::move(mArenas.back());
+        mArenas.pop_back();
+        return pArena;
+    }
+    void recycle(std::unique_ptr<MonotonicArena>&& apArena) {
+        if (mArenas.size() < mMaxArenas) {
+            apArena->reset();
+            mArenas.push_back(std::move(apArena));
+        }
+    }
+
+private:
+    const size_t                                    mBlockSize; ///< Size of the first block of the new arenas
+    const size_t                                    mMaxArenas; ///< Number of arenas kept
+    std::vector<std::unique_ptr<MonotonicArena>>    mArenas;    ///< Arenas ready, holding no Element
+};
+
+/**
+ * @brief Document built in an arena of a DocumentPool, selected for all the Elements built by the thread meanwhile.
+ *
+ * @code
+    void handleRequest(const Request& aRequest) {
+        HTML::PooledDocument page("Search results");
+        page->body() << (HTML::List() << HTML::ListItem(aRequest.query()));
+        send(page->toString());
+    } // the Document is destroyed, and its memory recycled for the next request of the thread
+ * @endcode
+ *
+ *   The PooledDocuments of a thread may be destroyed in any order (see ScopedResource): the thread then builds
+ * its Elements in the arena of the most recent one still alive.
+ *
+ * @warning Like with a ScopedResource, the Elements built by the thread during the life of the PooledDocument
+ *          (and the copies of the Document, like the one of a ChunkedWriter) must not outlive it: build an Element
+ *          kept longer, like a static navigation bar built on the first request, in its own scope of the global heap.
+ * @code
+    static const HTML::Element navbar = [] {
+        HTML::ScopedResource scope(HTML::newDeleteResource());
+        return buildNavbar();
+    }();
+ * @endcode
+ */
+class PooledDocument {
+public:
+    explicit PooledDocument(DocumentPool& aPool = DocumentPool::local()) :
+        mLease(aPool), mScope(*mLease.mpArena) {}
+    explicit PooledDocument(const char* apTitle, DocumentPool& aPool = DocumentPool::local()) :
+        mLease(aPool), mScope(*mLease.mpArena), mDocument(apTitle) {}
+
+    PooledDocument(const PooledDocument&) = delete;
+    PooledDocument& operator=(const PooledDocument&) = delete;
+
+    Document& document() {
+        return mDocument;
+    }
+    const Document& document() const {
+        return mDocument;
+    }
+    Document& operator*() {
+        return mDocument;
+    }
+    const Document& operator*() const {
+        return mDocument;
+    }
+    Document* operator->() {
+        return &mDocument;
+    }
+    const Document* operator->() const {
+        return &mDocument;
+    }
+
+private:
+    /// Arena taken from the pool, given back once the Document is destroyed
+    struct Lease {
+        explicit Lease(DocumentPool& aPool) : mPool(aPool), mpArena(aPool.acquire()) {}
+        ~Lease() {
+            mPool.recycle(std::move(mpArena));
+        }
+
+        DocumentPool&                   mPool;
+        std::unique_ptr<MonotonicArena> mpArena;
+    };
+
+private:
+    // Note: the members are destroyed in reverse order, so the Document before its arena
+    Lease           mLease;     ///< Arena of the Document
+    ScopedResource  mScope;     ///< Selection of the arena for the Elements built by the thread
+    Document        mDocument;  ///< Document built in the arena
+};
+
+} // namespace HTML
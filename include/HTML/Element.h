@@ -1,7 +1,7 @@
 /**
  * @file    Element.h
  * @ingroup HtmlBuilder
- * @brief   Definitions of an Element in the HTML Document Object Model, and various specialized Element types.
+ * @brief   Element of the HTML Document Object Model, with the text, Slot, Fragment and Shared specialized Elements.
  *
  * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
  *
@@ -10,950 +10,763 @@
  */
 #pragma once
 
-#include <sstream>
-#include <string>
-#include <vector>
+#include "Allocator.h"
+#include "Escape.h"
+#include "Instrumentation.h"
+#include "Layout.h"
+#include "Name.h"
+#include "Number.h"
+#include "Parallel.h"
+#include "SharedVector.h"
+#include "SmallVector.h"
+
 #include <algorithm>
 #include <iterator>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
 #include <utility>
 
-/// A simple C++ HTML Generator library.
-namespace HTML {
-
-// Note: to configure indentation & minification, define this at compile time before including HTML headers.
-#ifndef HTML_INDENTATION
-#define HTML_INDENTATION 2
+// Note: define this to 1 at compile time to link with the HtmlBuilder library, where the serialization of the
+// Elements is compiled once for the Layouts and Outputs of the library (see Render.h and src/HtmlBuilder.cpp)
+#ifndef HTML_COMPILED_LIBRARY
+#define HTML_COMPILED_LIBRARY 0
 #endif
-#ifndef HTML_ENDLINE
-#define HTML_ENDLINE "\n"
+
+// Note: number of attributes stored inline in each Element (like the href and the class of a Link), the next ones
+// being allocated; 0 minimizes the size of the Elements. Define it consistently in all the translation units.
+#ifndef HTML_INLINE_ATTRIBUTES
+#define HTML_INLINE_ATTRIBUTES 2
 #endif
 
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
 /// Convert a boolean to string like std::boolalpha in a std::ostream
 constexpr const char* to_string(bool aBool) {
     return aBool ? "true" : "false";
 }
 
 /**
- * @brief Definitions of an Element in the HTML Document Object Model, and various specialized Element types.
+ * @brief Output counting the characters that would be appended to a std::string, without writing anything.
  *
- * An Element represents any HTML node in the Document Object Model.
+ *   Mimics the subset of the std::string interface used by the Element serialization,
+ * so that the exact same code computes the size of the generated HTML (see Element::renderedSize()).
+ * By convention, append(count, char) is only ever used to write indentation.
  */
-class Element {
+class SizeCounter {
 public:
-    explicit Element(const char* apName, const char* apContent = nullptr) :
-        mName(apName), mContent(apContent ? apContent : "") {}
-    Element(const char* apName, std::string&& aContent) :
-        mName(apName), mContent(aContent) {}
-    Element(const char* apName, const std::string& aContent) :
-        mName(apName), mContent(aContent) {}
-
-    Element&& addAttribute(const char* apName, const std::string& aValue) {
-        mAttributes.push_back({apName, aValue});
-        return std::move(*this);
+    SizeCounter& append(const size_t aCount, char) {
+        mSize += aCount;
+        return *this;
     }
-    Element&& addAttribute(const char* apName, const unsigned int aValue) {
-        mAttributes.push_back({apName, std::to_string(aValue)});
-        return std::move(*this);
+    SizeCounter& append(const char*, const size_t aSize) {
+        mSize += aSize;
+        return *this;
     }
-    Element&& operator<<(Element&& aElement) {
-        mChildren.push_back(std::move(aElement));
-        return std::move(*this);
+    SizeCounter& operator+=(char) {
+        ++mSize;
+        return *this;
     }
-    Element&& operator<<(const char* apContent);
-    Element&& operator<<(std::string&& aContent);
-    Element&& operator<<(const std::string& aContent);
-
-    friend std::ostream& operator<<(std::ostream& aStream, const Element& aElement);
-    std::string toString() const {
-        std::ostringstream stream;
-        stream << *this;
-        return stream.str();
+    SizeCounter& operator+=(const std::string& aString) {
+        mSize += aString.size();
+        return *this;
     }
 
-    Element&& id(const std::string& aValue) {
-        return addAttribute("id", aValue);
-    }
-
-    Element&& cls(const std::string& aValue) {
-        return addAttribute("class", aValue);
-    }
-
-    Element&& title(const std::string& aValue) {
-        return addAttribute("title", aValue);
-    }
-
-    Element&& style(const std::string& aValue) {
-        return addAttribute("style", aValue);
-    }
-
-    struct Attribute {
-        std::string Name;
-        std::string Value;
-    };
-
-protected:
-    /// Constructor reserved for the Root \<html\> Element as well as the Empty
-    Element();
-
-    std::ostream& toString(std::ostream& aStream, const size_t aIndentation = 0) const {
-        toStringOpen(aStream, aIndentation);
-        toStringContent(aStream, aIndentation);
-        toStringClose(aStream, aIndentation);
-        return aStream;
+    size_t size() const {
+        return mSize;
     }
 
 private:
-    void toStringOpen(std::ostream& aStream, const size_t aIndentation) const {
-        if (!mName.empty()) {
-            std::fill_n(std::ostream_iterator<char>(aStream), aIndentation, ' ');
-            aStream << '<' << mName;
-
-            for (const auto& attr : mAttributes) {
-                aStream << ' ' << attr.Name;
-                if (!attr.Value.empty()) {
-                    aStream << "=\"" << attr.Value << "\"";
-                }
-            }
-
-            if (mContent.empty()) {
-                // Note: using children for content is less efficient/breaking the assumption
-                if (!mChildren.empty() || mbVoid) {
-                    aStream << ">" HTML_ENDLINE;
-                } else {
-                    aStream << ">";
-                }
-            } else {
-                aStream << '>';
-            }
-        }
-    }
-    void toStringContent(std::ostream& aStream, const size_t aIndentation) const {
-        if (!mName.empty()) {
-            aStream << mContent;
-            for (auto& child : mChildren) {
-                child.toString(aStream, aIndentation + HTML_INDENTATION);
-            }
-        } else {
-            std::fill_n(std::ostream_iterator<char>(aStream), aIndentation, ' ');
-            aStream << mContent << HTML_ENDLINE;
-        }
-    }
-    void toStringClose(std::ostream& aStream, const size_t aIndentation) const {
-        if (!mName.empty()) {
-            if (!mChildren.empty()) {
-                std::fill_n(std::ostream_iterator<char>(aStream), aIndentation, ' ');
-            }
-            // Note: using children for content is less efficient/breaking the assumption
-            if (!mContent.empty() || !mChildren.empty() || !mbVoid) {
-                aStream << "</" << mName << ">" HTML_ENDLINE;
-            }
-        }
-    }
-
-protected:
-    std::string mName;
-    std::string mContent;
-    std::vector<Attribute> mAttributes;
-    std::vector<Element> mChildren;
-
-    // Self-closing elements complete list:
-    // <br> <hr> <img> <input> <link> <meta> <col>
-    // <area> <base> <command> <embed> <keygen> <param> <source> <track> <wbr>
-    bool mbVoid = false;
-};
-
-inline std::ostream& operator<<(std::ostream& aStream, const Element& aElement) {
-    return aElement.toString(aStream);
-}
-
-/// Empty Element, useful as a default parameter for instance
-class Empty : public Element {
-public:
-    Empty() : Element() {}
-};
-
-/// Raw content text (unnamed Element) to use as text values between child Elements
-class Text : public Element {
-public:
-    explicit Text(const char* apContent) : Element("", apContent) {}
-    explicit Text(std::string&& aContent) : Element("", aContent) {}
-    explicit Text(const std::string& aContent) : Element("", aContent) {}
+    size_t mSize = 0;
 };
 
-inline Element&& Element::operator<<(const char* apContent) {
-    return *this << Text(apContent);
-}
-
-inline Element&& Element::operator<<(std::string&& aContent) {
-    return *this << Text(std::move(aContent));
-}
-
-inline Element&& Element::operator<<(const std::string& aContent) {
-    return *this << Text(aContent);
-}
-
-/// \<title\> Element required in \<head\>
-class Title : public Element {
-public:
-    explicit Title(const char* apContent) : Element("title", apContent) {}
-    explicit Title(const std::string& aContent) : Element("title", aContent) {}
-};
-
-/// \<style\> Element for inline CSS in \<head\>
-class Style : public Element {
+/**
+ * @brief Virtual interface to any Output, given to the Renderable content of an Element.
+ */
+class Writer {
 public:
-    explicit Style(const char* apContent) : Element("style", apContent) {}
-    explicit Style(const std::string& aContent) : Element("style", aContent) {}
-};
+    virtual ~Writer() {}
 
-/// \<script\> Element for inline Javascript in \<head\>
-class Script : public Element {
-public:
-    Script() : Element("script") {}
-    explicit Script(const char* apSrc) : Element("script") {
-        if (apSrc) {
-            addAttribute("src", apSrc);
-        }
-    }
-    explicit Script(const char* apSrc, const char* apContent) : Element("script", apContent) {
-        if (apSrc) {
-            addAttribute("src", apSrc);
-        }
-    }
-    Script&& integrity(const std::string& aValue) {
-        addAttribute("integrity", aValue);
-        return std::move(*this);
-    }
-    Script&& crossorigin(const std::string& aValue) {
-        addAttribute("crossorigin", aValue);
-        return std::move(*this);
+    /// Write some generated HTML
+    virtual void append(const char* apData, size_t aSize) = 0;
+    /// Write some generated HTML staying valid and unchanged during the whole serialization, that can be referenced
+    virtual void appendStable(const char* apData, size_t aSize) {
+        append(apData, aSize);
     }
+    /// Write the indentation at the beginning of a line, given as a number of spaces of the Pretty layout:
+    /// each level of Pretty::Indentation spaces is written with the indentation step of the layout of the Writer
+    virtual void indent(size_t aIndentation) = 0;
+    /// Write an end of line
+    virtual void endline() = 0;
 };
 
-/// \<meta\> metadata about the Document in \<head\>
-class Meta : public Element {
-public:
-    Meta() : Element("meta") {}
-    explicit Meta(const char* apCharset) : Element("meta") {
-        addAttribute("charset", apCharset);
-        mbVoid = true;
-    }
-    explicit Meta(const char* apName, const char* apContent) : Element("meta") {
-        addAttribute("name", apName);
-        addAttribute("content", apContent);
-        mbVoid = true;
+/**
+ * @brief Indentation in spaces of the Layout of a line of a Renderable content, rendered at aOrigin spaces,
+ *        from the indentation given to the Writer in spaces of the Pretty layout.
+ *
+ *   The levels of the content are scaled from Pretty::Indentation to Layout::Indentation spaces, so that a Fragment
+ * or a DataTable inserted into a PrettyLayout<4> is indented by 4 spaces per level like the Elements around it.
+ */
+template<typename Layout>
+size_t layoutIndentation(const size_t aOrigin, const size_t aIndentation) {
+    if ((Layout::Indentation == Pretty::Indentation) || (aIndentation < aOrigin)) {
+        return aIndentation;
     }
-};
+    return aOrigin + (aIndentation - aOrigin) * Layout::Indentation / Pretty::Indentation;
+}
 
-/// \<link\> Element to reference external CSS or Javascript files
-class Rel : public Element {
+/// Writer adapter for any Output with the std::string append interface, with the given layout policy
+template<typename Layout, typename Output>
+class OutputWriter : public Writer {
 public:
-    Rel(const char* apRel, const char* apUrl, const char* apType = nullptr) : Element("link") {
-        addAttribute("rel", apRel);
-        addAttribute("href", apUrl);
-        if (apType) {
-            addAttribute("type", apType);
-        }
-        mbVoid = true;
-    }
+    /// Writer of a content rendered at aOrigin spaces of the layout (see layoutIndentation())
+    explicit OutputWriter(Output& aOutput, const size_t aOrigin = 0) : mOutput(aOutput), mOrigin(aOrigin) {}
 
-    Rel&& integrity(const std::string& aValue) {
-        addAttribute("integrity", aValue);
-        return std::move(*this);
+    void append(const char* apData, size_t aSize) override {
+        mOutput.append(apData, aSize);
     }
-    Rel&& crossorigin(const std::string& aValue) {
-        addAttribute("crossorigin", aValue);
-        return std::move(*this);
+    void indent(size_t aIndentation) override {
+        Layout::indent(mOutput, layoutIndentation<Layout>(mOrigin, aIndentation));
     }
-};
-
-/// \<base\> Element in \<head\>
-class Base : public Element {
-public:
-    Base(const std::string& aContent, const std::string& aUrl, const char* apTarget) : Element("base", aContent) {
-        addAttribute("href", aUrl);
-        if (apTarget) {
-            addAttribute("target", apTarget);
-        }
+    void endline() override {
+        Layout::endline(mOutput);
     }
+
+private:
+    Output&         mOutput;
+    const size_t    mOrigin;    ///< Indentation of the content
 };
 
-/// \<head\> required as the first child Element in every HTML Document
-class Head : public Element {
+/// Output adapter for a Writer, with the std::string append interface, to render an Element from a Renderable
+class WriterOutput {
 public:
-    Head() : Element("head") {}
+    explicit WriterOutput(Writer& aWriter) : mWriter(aWriter) {}
 
-    Head&& operator<<(Element&& aElement) = delete;
-    Head&& operator<<(Title&& aTitle) {
-        mChildren.push_back(std::move(aTitle));
-        return std::move(*this);
+    void append(const char* apData, const size_t aSize) {
+        mWriter.append(apData, aSize);
     }
-    Head&& operator<<(Style&& aStyle) {
-        mChildren.push_back(std::move(aStyle));
-        return std::move(*this);
+    void append(const size_t aIndentation, char) {
+        mWriter.indent(aIndentation);
     }
-    Head&& operator<<(Script&& aScript) {
-        mChildren.push_back(std::move(aScript));
-        return std::move(*this);
+    void operator+=(const char aChar) {
+        mWriter.append(&aChar, 1);
     }
-    Head&& operator<<(Meta&& aMeta) {
-        mChildren.push_back(std::move(aMeta));
-        return std::move(*this);
+    void operator+=(const std::string& aString) {
+        mWriter.append(aString.data(), aString.size());
     }
-    Head&& operator<<(Rel&& aRel) {
-        mChildren.push_back(std::move(aRel));
-        return std::move(*this);
+    void endline() {
+        mWriter.endline();
     }
-    Head&& operator<<(Base&& aBase) {
-        mChildren.push_back(std::move(aBase));
-        return std::move(*this);
-    }
-};
 
-/// \<body\> required as the second child Element in every HTML Document
-class Body : public Element {
-public:
-    Body() : Element("body") {}
+private:
+    Writer& mWriter;
 };
 
-// Constructor of the Root \<html\> Element
-inline Element::Element() : mName("html"), mChildren{Head(), Body()} {
-}
-
+/// Layout policy forwarding the indentation and the ends of line to a Writer, which applies its own layout:
+/// the indentation is given in spaces of the Pretty layout, and scaled by the Writer (see Writer::indent())
+struct WriterLayout {
+    static const size_t Indentation = Pretty::Indentation;
+    static const bool IsObserved = false;
 
-/// \<br\> Line break Element
-class Break : public Element {
-public:
-    Break() : Element("br") {
-        mbVoid = true;
+    static void indent(WriterOutput& aOutput, const size_t aIndentation) {
+        aOutput.append(aIndentation, ' ');
     }
-};
-
-/// \<th\> Table Header Column Element
-class ColHeader : public Element {
-public:
-    explicit ColHeader(const char* apContent = nullptr) : Element("th", apContent) {}
-    explicit ColHeader(std::string&& aContent) : Element("th", aContent) {}
-    explicit ColHeader(const std::string& aContent) : Element("th", aContent) {}
-
-    ColHeader&& operator<<(Element&& aElement) {
-        mChildren.push_back(std::move(aElement));
-        return std::move(*this);
+    static void endline(WriterOutput& aOutput) {
+        aOutput.endline();
     }
-
-    ColHeader&& rowSpan(const unsigned int aNbRow) {
-        if (0 < aNbRow) {
-            addAttribute("rowspan", aNbRow);
-        }
-        return std::move(*this);
-    }
-    ColHeader&& colSpan(const unsigned int aNbCol) {
-        if (0 < aNbCol) {
-            addAttribute("colspan", aNbCol);
-        }
-        return std::move(*this);
+    static void tagEndline(WriterOutput& aOutput) {
+        aOutput += '>';
+        aOutput.endline();
     }
 };
 
-/// \<td\> Table Column Element
-class Col : public Element {
+/**
+ * @brief Content of an Element generated by custom code instead of the Document Object Model (see Fragment).
+ *
+ *   A Renderable is immutable and shared between Elements, so it must be safe to render concurrently.
+ */
+class Renderable {
 public:
-    explicit Col(const char* apContent = nullptr) : Element("td", apContent) {}
-    explicit Col(std::string&& aContent) : Element("td", aContent) {}
-    explicit Col(const std::string& aContent) : Element("td", aContent) {}
+    /// Number of rows of a content not made only of \<tr\> rows (see nbRows())
+    static const size_t NotRows = static_cast<size_t>(-1);
 
-    Col&& operator<<(Element&& aElement) {
-        mChildren.push_back(std::move(aElement));
-        return std::move(*this);
-    }
+    virtual ~Renderable() {}
 
-    Col&& rowSpan(const unsigned int aNbRow) {
-        if (0 < aNbRow) {
-            addAttribute("rowspan", aNbRow);
-        }
-        return std::move(*this);
-    }
-    Col&& colSpan(const unsigned int aNbCol) {
-        if (0 < aNbCol) {
-            addAttribute("colspan", aNbCol);
-        }
-        return std::move(*this);
-    }
-    Col&& style(const std::string& aValue) {
-        Element::style(aValue);
-        return std::move(*this);
+    /// Write the HTML of the content at the given indentation
+    virtual void render(Writer& aWriter, size_t aIndentation) const = 0;
+
+    /// Number of the \<tr\> rows making the whole content, like the rows of a DataTable, or NotRows by default
+    virtual size_t nbRows() const {
+        return NotRows;
     }
+    /// Write the HTML of one of these rows, so that they are compared one by one (see Diff)
+    virtual void renderRow(Writer&, size_t /* aRow */, size_t /* aIndentation */) const {}
 };
 
-/// \<tr\> Table Row Element
-class Row : public Element {
-public:
-    Row() : Element("tr") {}
+class Fragment;
 
-    Row&& operator<<(Element&& aElement) {
-        mChildren.push_back(std::move(aElement));
-        return std::move(*this);
-    }
+/**
+ * @brief Definitions of an Element in the HTML Document Object Model, and various specialized Element types.
+ *
+ * An Element represents any HTML node in the Document Object Model.
+ *
+ *   The const methods never modify the Element nor its children, so any number of threads can serialize the same
+ * Elements concurrently, as long as none of them modifies them meanwhile (see Shared for the subtrees shared by all).
+ */
+class Element {
+public:
+    explicit Element(const Name& aName, const char* apContent = nullptr) :
+        mName(aName), mContent(apContent ? apContent : "") {}
+    Element(const Name& aName, std::string&& aContent) :
+        mName(aName), mContent(std::move(aContent)) {}
+    Element(const Name& aName, const std::string& aContent) :
+        mName(aName), mContent(aContent) {}
 
-    Row&& operator<<(ColHeader&& aCol) {
-        mChildren.push_back(std::move(aCol));
+    Element&& addAttribute(const Name& aName, std::string&& aValue) {
+        mAttributes.emplace_back(aName, std::move(aValue));
         return std::move(*this);
     }
-    Row&& operator<<(Col&& aCol) {
-        mChildren.push_back(std::move(aCol));
+    Element&& addAttribute(const Name& aName, const std::string& aValue) {
+        mAttributes.emplace_back(aName, aValue);
         return std::move(*this);
     }
-    Row&& style(const std::string& aValue) {
-        Element::style(aValue);
+    /// Attribute with the value of a number (integer, floating-point or bool) formatted without any temporary string
+    template<typename T, typename = typename std::enable_if<IsNumber<T>::value>::type>
+    Element&& addAttribute(const Name& aName, const T aValue) {
+        const Number number(aValue);
+        mAttributes.emplace_back(aName, number.data(), number.size());
         return std::move(*this);
     }
-};
-
-/// \<caption\> Table Caption Element
-class Caption : public Element {
-public:
-    explicit Caption(const char* apContent) : Element("caption", apContent) {}
-};
-
-/// \<table\> Element
-class Table : public Element {
-public:
-    Table() : Element("table") {}
-
-    Table&& operator<<(Element&& aElement) = delete;
-    Table&& operator<<(Row&& aRow) {
-        mChildren.push_back(std::move(aRow));
+    /// Attribute with the value of a floating-point number, with the given notation and precision
+    Element&& addAttribute(const Name& aName, const double aValue, const FloatFormat aFormat) {
+        const Number number(aValue, aFormat);
+        mAttributes.emplace_back(aName, number.data(), number.size());
         return std::move(*this);
     }
-    Table&& operator<<(Caption&& aCaption) {
-        mChildren.push_back(std::move(aCaption));
+    /// Construct the value of an attribute in place, from the arguments of any std::string constructor
+    template<typename... Args>
+    Element&& emplaceAttribute(const Name& aName, Args&&... aArgs) {
+        mAttributes.emplace_back(aName, std::forward<Args>(aArgs)...);
         return std::move(*this);
     }
-};
-
-/// \<li\> List Item Element to put in List
-class ListItem : public Element {
-public:
-    ListItem() : Element("li") {}
-    explicit ListItem(const char* apContent) : Element("li", apContent) {}
-    explicit ListItem(const std::string& aContent) : Element("li", aContent) {}
-
-    ListItem&& operator<<(Element&& aElement) {
+    Element&& operator<<(Element&& aElement) {
         mChildren.push_back(std::move(aElement));
         return std::move(*this);
     }
+    Element&& operator<<(const char* apContent);
+    Element&& operator<<(std::string&& aContent);
+    Element&& operator<<(const std::string& aContent);
 
-    ListItem&& cls(const std::string& aValue) {
-        addAttribute("class", aValue);
+    /**
+     * @brief Remove the text, the attributes and the children, keeping the memory allocated for them.
+     *
+     *   The Element keeps its name, and its lists of attributes and of children are reused for the next ones,
+     * unless they are shared with copies of the Element. The content of a Renderable (like a Deferred, a Slot
+     * or a Shared subtree) is dropped too, so the Element becomes a plain one.
+     *
+     * @warning Clearing a Document removes its \<head\> and \<body\>: use Document::reset() instead.
+     */
+    Element&& clear() {
+        mContent.clear();
+        mAttributes.clear();
+        mChildren.clear();
+        mpRenderable.reset();
+        mbDeferred = false;
+        mbSlot = false;
+        mbShared = false;
         return std::move(*this);
     }
-};
 
-/// \<ol\> Ordered List or \<ul\> Unordered List Element to use with ListItem
-class List : public Element {
-public:
-    explicit List(const bool abOrdered = false) : Element(abOrdered?"ol":"ul") {}
-    List(const bool abOrdered, const char* apClass) : Element(abOrdered ?"ol":"ul") {
-        cls(apClass);
+    /// Reserve room for aNbChildren more children, to allocate them at once when their number is known up front
+    Element&& reserve(const size_t aNbChildren) {
+        mChildren.reserve(mChildren.size() + aNbChildren);
+        return std::move(*this);
     }
 
-    List&& operator<<(Element&& aElement) = delete;
-    List&& operator<<(ListItem&& aItem) {
-        mChildren.push_back(std::move(aItem));
+    /// Append any number of children at once like operator<<, moving the Elements and the rvalue strings
+    template<typename... Args>
+    Element&& add(Args&&... aChildren) {
+        // Note: the braced list evaluates the insertions in order, one for each child
+        const int expand[] = {0, ((void)(*this << std::forward<Args>(aChildren)), 0)...};
+        (void)expand;
         return std::move(*this);
     }
-};
 
-/// \<form\> Element
-class Form : public Element {
-public:
-    explicit Form(const char* apAction = nullptr, const char* apMethod = nullptr) : Element("form") {
-        if (apAction) {
-            addAttribute("action", apAction);
-        }
-        if (apMethod) {
-            addAttribute("method", apMethod);
-        }
-    }
-};
+    friend std::ostream& operator<<(std::ostream& aStream, const Element& aElement);
 
-/// \<input\> Element to use in Form
-class Input : public Element {
-public:
-    explicit Input(const char* apType = nullptr, const char* apName = nullptr,
-                   const char* apValue = nullptr, const char* apContent = nullptr) : Element("input", apContent) {
-        if (apType) {
-            addAttribute("type", apType);
-        }
-        if (apName) {
-            addAttribute("name", apName);
-        }
-        if (apValue) {
-            addAttribute("value", apValue);
+    /// Serialize the Element and all its children, with the Pretty layout by default, or the Minified one
+    template<typename Layout = Pretty>
+    std::string toString() const {
+        std::string buffer;
+        buffer.reserve(renderedSize<Layout>());
+        appendTo<Layout>(buffer);
+        return buffer;
+    }
+    /// Serialize the Element and all its children, with a layout selected at runtime
+    std::string toString(const Format aFormat) const {
+        return (Format::Minified == aFormat) ? toString<Minified>() : toString<Pretty>();
+    }
+
+    /**
+     * @brief Serialize the Element and all its children at the end of a caller-owned buffer.
+     *
+     *   This is the fast path of the library: everything is appended directly to the contiguous buffer,
+     * so the caller can reserve it once (see renderedSize()) and reuse it between renderings.
+     *
+     * @tparam        Layout        Layout policy, Pretty or Minified
+     * @param[in,out] aBuffer       Buffer to append the generated HTML to, or any Output like a VectoredOutput
+     * @param[in]     aIndentation  Number of spaces of indentation of the Element
+     *
+     * @return the buffer, to chain calls
+     */
+    template<typename Layout = Pretty, typename Output>
+    Output& appendTo(Output& aBuffer, const size_t aIndentation = 0) const {
+        render<Layout>(aBuffer, aIndentation);
+        return aBuffer;
+    }
+    template<typename Output>
+    Output& appendTo(Output& aBuffer, const Format aFormat, const size_t aIndentation = 0) const {
+        return (Format::Minified == aFormat) ? appendTo<Minified>(aBuffer, aIndentation)
+                                             : appendTo<Pretty>(aBuffer, aIndentation);
+    }
+
+    /**
+     * @brief Serialize the Element and all its children, the large lists of children being serialized in parallel.
+     *
+     * @param[in] aPolicy   Threads to use, number of children above which they are serialized in parallel, and layout
+     *
+     * @return the same HTML as toString(aPolicy.mFormat)
+     */
+    std::string toString(const ParallelPolicy& aPolicy) const {
+        std::string buffer;
+        appendTo(buffer, aPolicy);
+        return buffer;
+    }
+
+    /// Serialize at the end of a caller-owned buffer like appendTo(), the large lists of children in parallel
+    std::string& appendTo(std::string& aBuffer, const ParallelPolicy& aPolicy, const size_t aIndentation = 0) const {
+        if (Format::Minified == aPolicy.mFormat) {
+            render<Minified>(aBuffer, aIndentation, aPolicy);
+        } else {
+            render<Pretty>(aBuffer, aIndentation, aPolicy);
         }
-        mbVoid = true;
+        return aBuffer;
     }
 
-    Input&& addAttribute(const char* apName, const std::string& aValue) {
-        Element::addAttribute(apName, aValue);
-        return std::move(*this);
-    }
-    Input&& addAttribute(const char* apName, const unsigned int aValue) {
-        Element::addAttribute(apName, aValue);
-        return std::move(*this);
+    /// Serialize the Element and all its children to a Writer, for instance from the render() of a Renderable
+    void renderTo(Writer& aWriter, const size_t aIndentation = 0) const {
+        WriterOutput output(aWriter);
+        render<WriterLayout>(output, aIndentation);
     }
 
-    Input&& id(const std::string& aValue) {
-        return addAttribute("id", aValue);
-    }
-    Input&& cls(const std::string& aValue) {
-        return addAttribute("class", aValue);
+    /**
+     * @brief Compute the exact number of characters that appendTo() would generate, without generating them.
+     *
+     * @tparam    Layout        Layout policy, Pretty or Minified
+     * @param[in] aIndentation  Number of spaces of indentation of the Element
+     *
+     * @return the size of the generated HTML
+     */
+    template<typename Layout = Pretty>
+    size_t renderedSize(const size_t aIndentation = 0) const {
+        SizeCounter counter;
+        render<Layout>(counter, aIndentation);
+        return counter.size();
     }
-    Input&& title(const std::string& aValue) {
-        return addAttribute("title", aValue);
-    }
-    Input&& style(const std::string& aValue) {
-        return addAttribute("style", aValue);
+    size_t renderedSize(const Format aFormat, const size_t aIndentation = 0) const {
+        return (Format::Minified == aFormat) ? renderedSize<Minified>(aIndentation) : renderedSize<Pretty>(aIndentation);
     }
 
-    Input&& size(const unsigned int aSize) {
-        return addAttribute("size", aSize);
-    }
-    Input&& maxlength(const unsigned int aMaxlength) {
-        return addAttribute("maxlength", aMaxlength);
-    }
-    Input&& placeholder(const std::string& aPlaceholder) {
-        return addAttribute("placeholder", aPlaceholder);
+    /**
+     * @brief Compute the statistics of the serialization: number of nodes, depth, attributes and bytes per tag.
+     *
+     * @tparam    Layout        Layout policy, Pretty or Minified
+     * @param[in] aIndentation  Number of spaces of indentation of the Element
+     *
+     * @return the statistics, mBytes being the renderedSize()
+     */
+    template<typename Layout = Pretty>
+    RenderStats renderStats(const size_t aIndentation = 0) const {
+        RenderStats stats;
+        collectStats<Layout>(stats, aIndentation, 1);
+        return stats;
     }
-    Input&& min(const std::string& aMin) {
-        return addAttribute("min", aMin);
+    RenderStats renderStats(const Format aFormat, const size_t aIndentation = 0) const {
+        return (Format::Minified == aFormat) ? renderStats<Minified>(aIndentation) : renderStats<Pretty>(aIndentation);
     }
-    Input&& min(const unsigned int aMin) {
-        return addAttribute("min", aMin);
-    }
-    Input&& max(const std::string& aMax) { // NOLINT(build/include_what_you_use) false positive
-        return addAttribute("max", aMax);
-    }
-    Input&& max(const unsigned int aMax) { // NOLINT(build/include_what_you_use) false positive
-        return addAttribute("max", aMax);
+    Element&& id(std::string aValue) {
+        return addAttribute("id"_name, std::move(aValue));
     }
 
-    Input&& checked(const bool abChecked = true) {
-        if (abChecked) {
-            addAttribute("checked", "");
-        }
-        return std::move(*this);
-    }
-    Input&& autocomplete() {
-        return addAttribute("autocomplete", "");
-    }
-    Input&& autofocus() {
-        return addAttribute("autofocus", "");
+    Element&& cls(std::string aValue) {
+        return addAttribute("class"_name, std::move(aValue));
     }
-    Input&& disabled() {
-        return addAttribute("disabled", "");
-    }
-    Input&& readonly() {
-        return addAttribute("readonly", "");
-    }
-    Input&& required() {
-        return addAttribute("required", "");
-    }
-};
 
-/// \<input\> Radio Element to use in Form
-class InputRadio : public Input {
-public:
-    explicit InputRadio(const char* apName, const char* apValue = nullptr, const char* apContent = nullptr) :
-        Input("radio", apName, apValue, apContent) {
+    Element&& title(std::string aValue) {
+        return addAttribute("title"_name, std::move(aValue));
     }
-};
 
-/// \<input\> Checkbox Element to use in Form
-class InputCheckbox : public Input {
-public:
-    explicit InputCheckbox(const char* apName, const char* apValue = nullptr, const char* apContent = nullptr) :
-        Input("checkbox", apName, apValue, apContent) {
+    Element&& style(std::string aValue) {
+        return addAttribute("style"_name, std::move(aValue));
     }
-};
 
-/// \<input\> hidden Element to use in Form
-class InputHidden : public Input {
-public:
-    explicit InputHidden(const char* apName, const char* apValue = nullptr) :
-        Input("hidden", apName, apValue) {
-    }
-};
+    /// Serialize once the Element and its children into an immutable Fragment, cheap to copy and to render
+    Fragment freeze() const;
 
-/// \<input\> text Element to use in Form
-class InputText : public Input {
-public:
-    explicit InputText(const char* apName, const char* apValue = nullptr) :
-        Input("text", apName, apValue) {
-    }
-};
-
-/// \<textarea\> Element to use in Form
-class TextArea : public Element {
-public:
-    explicit TextArea(const char* apName, const unsigned int aCols = 0, const unsigned int aRows = 0) :
-        Element("textarea") {
-        addAttribute("name", apName);
-        if (0 < aCols) {
-            addAttribute("cols", aCols);
-        }
-        if (0 < aRows) {
-            addAttribute("rows", aRows);
-        }
-    }
-    TextArea&& maxlength(const unsigned int aMaxlength) {
-        addAttribute("maxlength", aMaxlength);
-        return std::move(*this);
-    }
-};
-
-/// \<intput\> Number Element to use in Form
-class InputNumber : public Input {
-public:
-    explicit InputNumber(const char* apName, const char* apValue = nullptr) :
-        Input("number", apName, apValue) {
-    }
-};
+    struct Attribute {
+        template<typename... Args>
+        Attribute(const HTML::Name& aName, Args&&... aArgs) : Name(aName), Value(std::forward<Args>(aArgs)...) {}
 
-/// \<intput\> Range Element to use in Form
-class InputRange : public Input {
-public:
-    explicit InputRange(const char* apName, const char* apValue = nullptr) :
-        Input("range", apName, apValue) {
-    }
-};
+        HTML::Name  Name;
+        std::string Value;
+    };
 
-/// \<intput\> Date Element to use in Form
-class InputDate : public Input {
-public:
-    explicit InputDate(const char* apName, const char* apValue = nullptr) :
-        Input("date", apName, apValue) {
-    }
-};
+    /// Number of attributes stored inline in an Element, without heap allocation (see HTML_INLINE_ATTRIBUTES)
+    static const size_t InlineAttributes = HTML_INLINE_ATTRIBUTES;
 
-/// \<intput\> Time Element to use in Form
-class InputTime : public Input {
-public:
-    explicit InputTime(const char* apName, const char* apValue = nullptr) :
-        Input("time", apName, apValue) {
-    }
-};
+    /// Attributes and children are allocated from the MemoryResource current at construction (see ScopedResource)
+    typedef SmallVector<Attribute, InlineAttributes, Allocator<Attribute>> Attributes;
+    /// Children are shared by the copies of an Element until modified, so copying a tree is cheap
+    typedef SharedVector<Element, Allocator<Element>> Children;
 
-/// \<intput\> E-mail Element to use in Form
-class InputEmail : public Input {
-public:
-    explicit InputEmail(const char* apName, const char* apValue = nullptr) :
-        Input("email", apName, apValue) {
-    }
-};
+protected:
+    /// Constructor reserved for the Root \<html\> Element as well as the Empty
+    Element();
 
-/// \<intput\> URL Element to use in Form
-class InputUrl : public Input {
-public:
-    explicit InputUrl(const char* apName, const char* apValue = nullptr) :
-        Input("url", apName, apValue) {
+    /// Append a string literal (like "<!DOCTYPE html>") without strlen()
+    template<typename Output, size_t N>
+    static void append(Output& aBuffer, const char (&aLiteral)[N]) {
+        aBuffer.append(aLiteral, N - 1);
     }
-};
 
-/// \<intput\> Password Element to use in Form
-class InputPassword : public Input {
-public:
-    explicit InputPassword(const char* apName) :
-        Input("password", apName) {
-    }
-};
+    /// Serialize the Element to any Output with the std::string append interface (std::string or SizeCounter)
+    template<typename Layout, typename Output>
+    void render(Output& aBuffer, const size_t aIndentation) const;
 
-/// \<intput\> Submit Button Element to use in Form
-class InputSubmit : public Input {
-public:
-    explicit InputSubmit(const char* apValue = nullptr, const char* apName = nullptr) :
-        Input("submit", apName, apValue) {
-    }
-};
+    /// Serialize the Element like render(), the lists of at least aPolicy.mMinChildren children in parallel
+    template<typename Layout>
+    void render(std::string& aBuffer, const size_t aIndentation, const ParallelPolicy& aPolicy) const;
 
-/// \<intput\> Reset Button Element to use in Form
-class InputReset : public Input {
-public:
-    explicit InputReset(const char* apValue = nullptr) :
-        Input("reset", nullptr, apValue) {
-    }
-};
+private:
+    friend class StreamWriter;
+    friend class ChunkedWriter;
+    friend class DataTable;
+    friend class Diff;
+    friend class Document;
+    friend class Fragment;
+    friend class FlatDocument;
+    friend class Template;
+
+    /// Serialize consecutive chunks of children into their own buffer on the ThreadPool, then concatenate them
+    template<typename Layout>
+    void renderChildren(std::string& aBuffer, const size_t aIndentation, const ParallelPolicy& aPolicy) const;
+
+    /// Serialize the Element like render(), calling the RenderObserver around each phase
+    template<typename Layout, typename Output>
+    void renderObserved(RenderObserver& aObserver, Output& aBuffer, const size_t aIndentation) const;
+
+    /// Measure the HTML generated by the Element itself, then by each of its children
+    template<typename Layout>
+    void collectStats(RenderStats& aStats, const size_t aIndentation, const size_t aDepth) const;
+
+    /// Indentation, name and attributes of the opening tag, without the closing '>'
+    template<typename Layout, typename Output>
+    void toStringTag(Output& aBuffer, const size_t aIndentation) const;
+    template<typename Layout, typename Output>
+    void toStringOpen(Output& aBuffer, const size_t aIndentation) const;
+    /// Text content, escaped unless the Element is a Raw one
+    template<typename Output>
+    void toStringText(Output& aBuffer) const;
+    template<typename Layout, typename Output>
+    void toStringContent(Output& aBuffer, const size_t aIndentation) const;
+    template<typename Layout, typename Output>
+    void toStringClose(Output& aBuffer, const size_t aIndentation) const;
+protected:
+    Name mName;
+    std::string mContent;
+    Attributes mAttributes;
+    Children mChildren;
 
-/// \<intput\> List Element to use in Form with DataList
-class InputList : public Input {
-public:
-    explicit InputList(const char* apName, const char* apList) : Input(nullptr, apName) {
-        addAttribute("list", apList);
-    }
-};
+    // Self-closing elements complete list:
+    // <br> <hr> <img> <input> <link> <meta> <col>
+    // <area> <base> <command> <embed> <keygen> <param> <source> <track> <wbr>
+    bool mbVoid = false;
 
-/// \<datalist\> Element for InputList, to use with Option Elements
-class DataList : public Element {
-public:
-    explicit DataList(const char* apId) : Element("datalist") {
-        addAttribute("id", apId);
-    }
-};
+    // Trusted content written as is, without escaping special characters: <style>, <script> and Raw text
+    bool mbRaw = false;
 
-/// \<select\> Element to use with Option Elements
-class Select : public Element {
-public:
-    explicit Select(const char* apName) : Element("select") {
-        addAttribute("name", apName);
-    }
-};
+    // Content resolved later by a Deferred, whose state is the Renderable
+    bool mbDeferred = false;
 
-/// \<option\> Element for Select and DataList
-class Option : public Element {
-public:
-    explicit Option(const char* apValue, const char* apContent = nullptr) : Element("option", apContent) {
-        addAttribute("value", apValue);
-    }
+    // Dynamic region of a Template, whose default content is the Renderable
+    bool mbSlot = false;
 
-    Option&& selected(const bool abSelected = true) {
-        if (abSelected) {
-            addAttribute("selected", "");
-        }
-        return std::move(*this);
-    }
-};
+    // Immutable subtree shared between threads, whose Renderable holds the Element rendered in place (see Shared)
+    bool mbShared = false;
 
-/// \<h1\> Element
-class Header1 : public Element {
-public:
-    explicit Header1(const std::string& aContent) : Element("h1", aContent) {}
+    // Content generated by custom code, replacing the whole Element (name, attributes, content and children)
+    std::shared_ptr<const Renderable> mpRenderable;
 };
 
-/// \<h2\> Element
-class Header2 : public Element {
+/// Empty Element, useful as a default parameter for instance
+class Empty : public Element {
 public:
-    explicit Header2(const std::string& aContent) : Element("h2", aContent) {}
+    Empty() : Element() {}
 };
 
-/// \<h3\> Element
-class Header3 : public Element {
+/// Text content (unnamed Element, with special characters escaped) to use as text values between child Elements
+class Text : public Element {
 public:
-    explicit Header3(const std::string& aContent) : Element("h3", aContent) {}
+    explicit Text(const char* apContent) : Element(""_name, apContent) {}
+    explicit Text(std::string&& aContent) : Element(""_name, std::move(aContent)) {}
+    explicit Text(const std::string& aContent) : Element(""_name, aContent) {}
+    /// Text of a number (integer, floating-point or bool), like "42", "0.1" or "true"
+    template<typename T, typename = typename std::enable_if<IsNumber<T>::value>::type>
+    explicit Text(const T aValue) : Element(""_name, Number(aValue).str()) {}
+    /// Text of a floating-point number, with the given notation and precision
+    Text(const double aValue, const FloatFormat aFormat) : Element(""_name, Number(aValue, aFormat).str()) {}
 };
 
-/// \<b\> bold Element
-class Bold : public Element {
+/// Raw content text (unnamed Element) to insert trusted or pre-escaped HTML as is, without any escaping
+class Raw : public Element {
 public:
-    explicit Bold(const std::string& aContent) : Element("b", aContent) {}
+    explicit Raw(const char* apContent) : Element(""_name, apContent) {
+        mbRaw = true;
+    }
+    explicit Raw(std::string&& aContent) : Element(""_name, std::move(aContent)) {
+        mbRaw = true;
+    }
+    explicit Raw(const std::string& aContent) : Element(""_name, aContent) {
+        mbRaw = true;
+    }
 };
 
-/// \<i\> italic Element
-class Italic : public Element {
+/**
+ * @brief Named dynamic region of a Template, like the user name or the body of a table (unnamed Element).
+ *
+ *   Outside of a Template, a Slot renders its default content (nothing by default) like any child Element.
+ * A Slot is accepted as a child by any Element, including a Table for its rows and a List for its items.
+ */
+class Slot : public Element {
 public:
-    explicit Italic(const std::string& aContent) : Element("i", aContent) {}
-};
+    /// Slot rendering nothing until set
+    explicit Slot(const Name& aName) : Slot(aName, std::shared_ptr<const Element>()) {}
+    /// Slot rendering the given Element until set
+    Slot(const Name& aName, Element&& aDefault) : Slot(aName, std::make_shared<const Element>(std::move(aDefault))) {}
 
-/// \<small\> Element for side-comment text and small print, including copyright and legal text
-class Small : public Element {
-public:
-    Small() : Element("small") {}
-    explicit Small(const char* apContent) : Element("small", apContent) {}
-    explicit Small(std::string&& aContent) : Element("small", aContent) {}
-    explicit Small(const std::string& aContent) : Element("small", aContent) {}
-};
+private:
+    friend class Template;
 
-/// \<strong\> Element for important text
-class Strong : public Element {
-public:
-    Strong() : Element("strong") {}
-    explicit Strong(const char* apContent) : Element("strong", apContent) {}
-    explicit Strong(std::string&& aContent) : Element("strong", aContent) {}
-    explicit Strong(const std::string& aContent) : Element("strong", aContent) {}
-};
+    /// Name and default content of the Slot
+    struct Content : public Renderable {
+        Content(const Name& aName, std::shared_ptr<const Element>&& apDefault) :
+            mName(aName), mpDefault(std::move(apDefault)) {}
 
-/// \<p\> paragraph Element
-class Paragraph : public Element {
-public:
-    explicit Paragraph(const std::string& aContent) : Element("p", aContent) {}
-};
+        void render(Writer& aWriter, const size_t aIndentation) const override {
+            if (mpDefault) {
+                mpDefault->renderTo(aWriter, aIndentation);
+            }
+        }
 
-/// \<div\> division Element to group elements in a rectangular block.
-class Div : public Element {
-public:
-    Div() : Element("div") {}
-    explicit Div(const char* apClass) : Element("div") {
-        cls(apClass);
-    }
+        Name                            mName;      ///< Name of the Slot in the Template
+        std::shared_ptr<const Element>  mpDefault;  ///< Rendered until set, if any
+    };
 
-    Div&& cls(const std::string& aValue) {
-        addAttribute("class", aValue);
-        return std::move(*this);
+    Slot(const Name& aName, std::shared_ptr<const Element>&& apDefault) : Element(""_name) {
+        mpRenderable = std::make_shared<const Content>(aName, std::move(apDefault));
+        mbSlot = true;
     }
 };
 
-/// \<span\> Element to group inline-elements in a document.
-class Span : public Element {
-public:
-    explicit Span(const std::string& aContent) : Element("span", aContent) {}
-};
+inline Element&& Element::operator<<(const char* apContent) {
+    return *this << Text(apContent);
+}
 
-/// \<pre\> pre-formatted Element to display text in mono-space font.
-class Pre : public Element {
-public:
-    explicit Pre(const std::string& aContent) : Element("pre", aContent) {}
-};
+inline Element&& Element::operator<<(std::string&& aContent) {
+    return *this << Text(std::move(aContent));
+}
 
-/// \<a\> Hyper-Link Element
-class Link : public Element {
-public:
-    Link() : Element("a") {}
-    explicit Link(const char* apContent) : Element("a", apContent) {}
-    explicit Link(const char* apContent, const char* apUrl = nullptr) : Element("a", apContent) {
-        if (apUrl) {
-            addAttribute("href", apUrl);
-        }
-    }
-    Link(const std::string& aContent, const std::string& aUrl) : Element("a", aContent) {
-        if (!aUrl.empty()) {
-            addAttribute("href", aUrl);
-        }
-    }
-    Link&& target(const char* apValue) {
-        addAttribute("target", apValue);
-        return std::move(*this);
-    }
-};
+inline Element&& Element::operator<<(const std::string& aContent) {
+    return *this << Text(aContent);
+}
 
-/// \<img\> Image Element
-class Image : public Element {
-public:
-    Image(const std::string& aSrc, const std::string& aAlt, unsigned int aWidth = 0, unsigned int aHeight = 0) :
-        Element("img") {
-        addAttribute("src", aSrc);
-        addAttribute("alt", aAlt);
-        if (0 < aWidth) {
-            addAttribute("width", aWidth);
-        }
-        if (0 < aHeight) {
-            addAttribute("height", aHeight);
+/**
+ * @brief Immutable pre-rendered subtree, serialized once and then shared between Documents (see Element::freeze()).
+ *
+ *   The HTML is generated once without any layout, recording where each line is indented or ended, so that a Fragment
+ * is written with a few memcpy in any layout, rebasing the indentation of each line to its insertion depth
+ * by levels of the layout (see Writer::indent()).
+ * A copy of a Fragment only copies a shared pointer, and a Fragment can be rendered concurrently by many threads.
+ *
+ * @code
+    static const HTML::Fragment navbar = buildNavbar().freeze();
+    document << HTML::Fragment(navbar);
+ * @endcode
+ */
+class Fragment : public Element {
+public:
+    /// Freeze an Element and its children
+    explicit Fragment(const Element& aElement) : Element(""_name) {
+        std::shared_ptr<Frozen> pFrozen = std::make_shared<Frozen>();
+        pFrozen->mHtml.reserve(aElement.renderedSize<Minified>());
+        FreezeWriter writer(*pFrozen);
+        aElement.renderTo(writer, 0);
+        mpRenderable = std::move(pFrozen);
+    }
+
+    /// Freeze the children of an Element, to insert them as siblings (for instance the shared part of a \<head\>)
+    static Fragment children(const Element& aParent) {
+        Fragment fragment;
+        std::shared_ptr<Frozen> pFrozen = std::make_shared<Frozen>();
+        FreezeWriter writer(*pFrozen);
+        for (const auto& child : aParent.mChildren) {
+            child.renderTo(writer, 0);
         }
-        mbVoid = true;
+        fragment.mpRenderable = std::move(pFrozen);
+        return fragment;
     }
-};
 
-/// \<progress\> Element
-class Progress : public Element {
-public:
-    Progress(const unsigned int aValue, const unsigned int aMax) : Element("progress") {
-        addAttribute("value", aValue);
-        addAttribute("max", aMax);
+    /// Generated HTML, at indentation zero, with the Pretty layout
+    std::string html() const {
+        std::string html;
+        OutputWriter<Pretty, std::string> writer(html);
+        mpRenderable->render(writer, 0);
+        return html;
     }
-};
 
-/// \<meter\> gauge Element
-class Meter : public Element {
-public:
-    Meter(const unsigned int aValue, const unsigned int aMin, const unsigned int aMax) : Element("meter") {
-        addAttribute("value", aValue);
-        addAttribute("min", aMin);
-        addAttribute("max", aMax);
-    }
-};
+    /// The frozen HTML is immutable
+    Fragment&& clear() = delete;
 
-/// \<mark\> semantic Element
-class Mark : public Element {
-public:
-    explicit Mark(const std::string& aContent) : Element("mark", aContent) {}
-};
+private:
+    Fragment() : Element(""_name) {}
 
-/// \<time\> semantic Element
-class Time : public Element {
-public:
-    explicit Time(const std::string& aContent, const std::string& aDateTime) : Element("time", aContent) {
-        addAttribute("datetime", aDateTime);
-    }
-};
+    /// Position in the HTML where a line is indented or ended
+    struct Break {
+        size_t  mOffset;        ///< Offset in the HTML
+        size_t  mIndentation;   ///< Indentation at indentation zero, or EndLine
+    };
+    static const size_t EndLine = static_cast<size_t>(-1);
+
+    /// Shared immutable HTML of the Fragment
+    struct Frozen : public Renderable {
+        std::string         mHtml;      ///< Generated HTML, without indentation nor end of line
+        std::vector<Break>  mBreaks;    ///< Positions in the HTML where a line is indented or ended
+
+        void render(Writer& aWriter, const size_t aIndentation) const override {
+            size_t begin = 0;
+            for (const Break& lineBreak : mBreaks) {
+                aWriter.appendStable(mHtml.data() + begin, lineBreak.mOffset - begin);
+                if (EndLine == lineBreak.mIndentation) {
+                    aWriter.endline();
+                } else {
+                    aWriter.indent(aIndentation + lineBreak.mIndentation);
+                }
+                begin = lineBreak.mOffset;
+            }
+            aWriter.appendStable(mHtml.data() + begin, mHtml.size() - begin);
+        }
+    };
 
-/// \<header\> semantic Element
-class Header : public Element {
-public:
-    Header() : Element("header") {}
-};
+    /// Writer generating the HTML of a Fragment, recording where each line is indented or ended
+    class FreezeWriter : public Writer {
+    public:
+        explicit FreezeWriter(Frozen& aFrozen) : mFrozen(aFrozen) {}
 
-/// \<footer\> semantic Element
-class Footer : public Element {
-public:
-    Footer() : Element("footer") {}
-};
+        void append(const char* apData, const size_t aSize) override {
+            mFrozen.mHtml.append(apData, aSize);
+        }
+        void indent(const size_t aIndentation) override {
+            mFrozen.mBreaks.push_back({mFrozen.mHtml.size(), aIndentation});
+        }
+        void endline() override {
+            mFrozen.mBreaks.push_back({mFrozen.mHtml.size(), EndLine});
+        }
 
-/// \<section\> semantic Element
-class Section : public Element {
-public:
-    Section() : Element("section") {}
+    private:
+        Frozen& mFrozen;
+    };
 };
 
-/// \<article\> semantic Element
-class Article : public Element {
-public:
-    Article() : Element("article") {}
-};
+inline Fragment Element::freeze() const {
+    return Fragment(*this);
+}
 
-/// \<nav\> semantic Element
-class Nav : public Element {
+/**
+ * @brief Immutable subtree shared by reference between the Documents of all the threads (unnamed Element).
+ *
+ *   The Element and its children are copied once to the global heap, then a copy of a Shared only copies a shared
+ * pointer, even in the arena of a PooledDocument: the threads insert the same \<head\> content or navigation bar into
+ * their own Documents without copying it, and serialize it concurrently without any lock. Unlike a Fragment,
+ * the subtree is not pre-rendered but serialized in place like the other children, with the layout of the Document.
+ *
+ * @code
+    static const HTML::Shared navbar(buildNavbar());
+    HTML::PooledDocument page("Search results");
+    page->body() << HTML::Shared(navbar) << buildResults(aRequest);
+ * @endcode
+ *
+ * @warning Like the content of a Fragment, the Elements of a shared subtree are not searched by getElementById(),
+ *          nor by a Template for its Slots.
+ */
+class Shared : public Element {
 public:
-    Nav() : Element("nav") {}
-    explicit Nav(const char* apClass) : Element("nav") {
-        cls(apClass);
+    /// Share a copy of an Element and of its children
+    explicit Shared(const Element& aElement) : Element(""_name) {
+        // Note: copied outside of the arena of the thread if any, since the copies of a Shared can outlive it
+        ScopedResource scope(newDeleteResource());
+        mpRenderable = std::make_shared<const Content>(aElement);
+        mbShared = true;
     }
-};
 
-/// \<aside\> semantic Element
-class Aside : public Element {
-public:
-    Aside() : Element("aside") {}
-};
+    /// The shared subtree
+    const Element& element() const {
+        return static_cast<const Content&>(*mpRenderable).mElement;
+    }
 
-/// \<main\> semantic Element
-class Main : public Element {
-public:
-    Main() : Element("main") {}
-};
+    /// The shared subtree is immutable
+    Shared&& clear() = delete;
 
-/// \<figure\> semantic Element
-class Figure : public Element {
-public:
-    Figure() : Element("figure") {}
-};
+private:
+    friend class Element;
+    friend class Diff;
 
-/// \<figcaption\> semantic Element to use with Figure
-class FigCaption : public Element {
-public:
-    explicit FigCaption(const std::string& aContent) : Element("figcaption", aContent) {}
-};
+    /// Shared immutable copy of the Element
+    struct Content : public Renderable {
+        explicit Content(const Element& aElement) : mElement(aElement) {}
 
-/** @brief \<details\> semantic Element containing detailed information to use with Summary.
- *
- * @verbatim
-<details>
-  <summary>Copyright 2017-2018.</summary>
-  <p>By Sebastien Rombauts.</p>
-  <p>sebastien.rombauts@gmail.com.</p>
-</details> @endverbatim
- */
-class Details : public Element {
-public:
-    explicit Details(const char* apOpen = nullptr) : Element("details") {
-        if (apOpen) {
-            addAttribute("open", apOpen);
+        void render(Writer& aWriter, const size_t aIndentation) const override {
+            mElement.renderTo(aWriter, aIndentation);
         }
-    }
-};
 
-/// \<summary\> semantic Element to use inside a Details section to specify a visible heading
-class Summary : public Element {
-public:
-    explicit Summary(const std::string& aContent) : Element("summary", aContent) {}
+        const Element mElement; ///< Root of the shared subtree
+    };
 };
 
+/// Reserve all the children of a forward range in a single allocation
+template<typename Iterator>
+void reserveRange(Element::Children& aChildren, const Iterator aBegin, const Iterator aEnd,
+                  std::forward_iterator_tag) {
+    aChildren.reserve(aChildren.size() + static_cast<size_t>(std::distance(aBegin, aEnd)));
+}
+/// An input range can only be read once: its children are appended one by one
+template<typename Iterator>
+void reserveRange(Element::Children&, const Iterator, const Iterator, std::input_iterator_tag) {
+}
+
+/// Append a range of values at once, constructing a child of type Child from each value
+template<typename Child, typename Iterator>
+void appendRange(Element::Children& aChildren, Iterator aBegin, const Iterator aEnd) {
+    reserveRange(aChildren, aBegin, aEnd, typename std::iterator_traits<Iterator>::iterator_category());
+    for (; aBegin != aEnd; ++aBegin) {
+        aChildren.push_back(Child(*aBegin));
+    }
+}
 
 } // namespace HTML
+
+#if !HTML_COMPILED_LIBRARY
+#include "Render.h"
+#endif
@@ -0,0 +1,329 @@
+/**
+ * @file    Elements.h
+ * @ingroup HtmlBuilder
+ * @brief   Text-level, grouping and sectioning Elements of the \<body\>: headings, paragraphs, links, lists...
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Element.h"
+
+#include <string>
+#include <utility>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/// \<br\> Line break Element
+class Break : public Element {
+public:
+    Break() : Element("br"_name) {
+        mbVoid = true;
+    }
+};
+
+/// \<li\> List Item Element to put in List
+class ListItem : public Element {
+public:
+    ListItem() : Element("li"_name) {}
+    explicit ListItem(const char* apContent) : Element("li"_name, apContent) {}
+    explicit ListItem(std::string&& aContent) : Element("li"_name, std::move(aContent)) {}
+    explicit ListItem(const std::string& aContent) : Element("li"_name, aContent) {}
+
+    ListItem&& operator<<(Element&& aElement) {
+        mChildren.push_back(std::move(aElement));
+        return std::move(*this);
+    }
+
+    ListItem&& cls(std::string aValue) {
+        addAttribute("class"_name, std::move(aValue));
+        return std::move(*this);
+    }
+};
+
+/// \<ol\> Ordered List or \<ul\> Unordered List Element to use with ListItem
+class List : public Element {
+public:
+    explicit List(const bool abOrdered = false) : Element(abOrdered ? "ol"_name : "ul"_name) {}
+    List(const bool abOrdered, const char* apClass) : Element(abOrdered ? "ol"_name : "ul"_name) {
+        cls(apClass);
+    }
+
+    List&& operator<<(Element&& aElement) = delete;
+    List&& operator<<(Slot&& aSlot) {
+        mChildren.push_back(std::move(aSlot));
+        return std::move(*this);
+    }
+    List&& operator<<(Shared&& aShared) {
+        mChildren.push_back(std::move(aShared));
+        return std::move(*this);
+    }
+    List&& operator<<(ListItem&& aItem) {
+        mChildren.push_back(std::move(aItem));
+        return std::move(*this);
+    }
+
+    List&& reserve(const size_t aNbItems) {
+        Element::reserve(aNbItems);
+        return std::move(*this);
+    }
+    /// Append a ListItem for each value of a range: strings, or ListItem Elements
+    template<typename Iterator>
+    List&& addItems(const Iterator aBegin, const Iterator aEnd) {
+        appendRange<ListItem>(mChildren, aBegin, aEnd);
+        return std::move(*this);
+    }
+    template<typename Range>
+    List&& addItems(const Range& aRange) {
+        return addItems(std::begin(aRange), std::end(aRange));
+    }
+};
+
+/// \<h1\> Element
+class Header1 : public Element {
+public:
+    explicit Header1(std::string&& aContent) : Element("h1"_name, std::move(aContent)) {}
+    explicit Header1(const std::string& aContent) : Element("h1"_name, aContent) {}
+};
+
+/// \<h2\> Element
+class Header2 : public Element {
+public:
+    explicit Header2(std::string&& aContent) : Element("h2"_name, std::move(aContent)) {}
+    explicit Header2(const std::string& aContent) : Element("h2"_name, aContent) {}
+};
+
+/// \<h3\> Element
+class Header3 : public Element {
+public:
+    explicit Header3(std::string&& aContent) : Element("h3"_name, std::move(aContent)) {}
+    explicit Header3(const std::string& aContent) : Element("h3"_name, aContent) {}
+};
+
+/// \<b\> bold Element
+class Bold : public Element {
+public:
+    explicit Bold(std::string&& aContent) : Element("b"_name, std::move(aContent)) {}
+    explicit Bold(const std::string& aContent) : Element("b"_name, aContent) {}
+};
+
+/// \<i\> italic Element
+class Italic : public Element {
+public:
+    explicit Italic(std::string&& aContent) : Element("i"_name, std::move(aContent)) {}
+    explicit Italic(const std::string& aContent) : Element("i"_name, aContent) {}
+};
+
+/// \<small\> Element for side-comment text and small print, including copyright and legal text
+class Small : public Element {
+public:
+    Small() : Element("small"_name) {}
+    explicit Small(const char* apContent) : Element("small"_name, apContent) {}
+    explicit Small(std::string&& aContent) : Element("small"_name, std::move(aContent)) {}
+    explicit Small(const std::string& aContent) : Element("small"_name, aContent) {}
+};
+
+/// \<strong\> Element for important text
+class Strong : public Element {
+public:
+    Strong() : Element("strong"_name) {}
+    explicit Strong(const char* apContent) : Element("strong"_name, apContent) {}
+    explicit Strong(std::string&& aContent) : Element("strong"_name, std::move(aContent)) {}
+    explicit Strong(const std::string& aContent) : Element("strong"_name, aContent) {}
+};
+
+/// \<p\> paragraph Element
+class Paragraph : public Element {
+public:
+    explicit Paragraph(std::string&& aContent) : Element("p"_name, std::move(aContent)) {}
+    explicit Paragraph(const std::string& aContent) : Element("p"_name, aContent) {}
+};
+
+/// \<div\> division Element to group elements in a rectangular block.
+class Div : public Element {
+public:
+    Div() : Element("div"_name) {}
+    explicit Div(const char* apClass) : Element("div"_name) {
+        cls(apClass);
+    }
+
+    Div&& cls(std::string aValue) {
+        addAttribute("class"_name, std::move(aValue));
+        return std::move(*this);
+    }
+};
+
+/// \<span\> Element to group inline-elements in a document.
+class Span : public Element {
+public:
+    explicit Span(std::string&& aContent) : Element("span"_name, std::move(aContent)) {}
+    explicit Span(const std::string& aContent) : Element("span"_name, aContent) {}
+};
+
+/// \<pre\> pre-formatted Element to display text in mono-space font.
+class Pre : public Element {
+public:
+    explicit Pre(std::string&& aContent) : Element("pre"_name, std::move(aContent)) {}
+    explicit Pre(const std::string& aContent) : Element("pre"_name, aContent) {}
+};
+
+/// \<a\> Hyper-Link Element
+class Link : public Element {
+public:
+    Link() : Element("a"_name) {}
+    explicit Link(const char* apContent) : Element("a"_name, apContent) {}
+    explicit Link(const char* apContent, const char* apUrl = nullptr) : Element("a"_name, apContent) {
+        if (apUrl) {
+            addAttribute("href"_name, apUrl);
+        }
+    }
+    Link(std::string aContent, std::string aUrl) : Element("a"_name, std::move(aContent)) {
+        if (!aUrl.empty()) {
+            addAttribute("href"_name, std::move(aUrl));
+        }
+    }
+    Link&& target(const char* apValue) {
+        addAttribute("target"_name, apValue);
+        return std::move(*this);
+    }
+};
+
+/// \<img\> Image Element
+class Image : public Element {
+public:
+    Image(std::string aSrc, std::string aAlt, unsigned int aWidth = 0, unsigned int aHeight = 0) :
+        Element("img"_name) {
+        addAttribute("src"_name, std::move(aSrc));
+        addAttribute("alt"_name, std::move(aAlt));
+        if (0 < aWidth) {
+            addAttribute("width"_name, aWidth);
+        }
+        if (0 < aHeight) {
+            addAttribute("height"_name, aHeight);
+        }
+        mbVoid = true;
+    }
+};
+
+/// \<progress\> Element
+class Progress : public Element {
+public:
+    Progress(const double aValue, const double aMax) : Element("progress"_name) {
+        addAttribute("value"_name, aValue);
+        addAttribute("max"_name, aMax);
+    }
+};
+
+/// \<meter\> gauge Element
+class Meter : public Element {
+public:
+    Meter(const double aValue, const double aMin, const double aMax) : Element("meter"_name) {
+        addAttribute("value"_name, aValue);
+        addAttribute("min"_name, aMin);
+        addAttribute("max"_name, aMax);
+    }
+};
+
+/// \<mark\> semantic Element
+class Mark : public Element {
+public:
+    explicit Mark(std::string&& aContent) : Element("mark"_name, std::move(aContent)) {}
+    explicit Mark(const std::string& aContent) : Element("mark"_name, aContent) {}
+};
+
+/// \<time\> semantic Element
+class Time : public Element {
+public:
+    explicit Time(std::string aContent, std::string aDateTime) : Element("time"_name, std::move(aContent)) {
+        addAttribute("datetime"_name, std::move(aDateTime));
+    }
+};
+
+/// \<header\> semantic Element
+class Header : public Element {
+public:
+    Header() : Element("header"_name) {}
+};
+
+/// \<footer\> semantic Element
+class Footer : public Element {
+public:
+    Footer() : Element("footer"_name) {}
+};
+
+/// \<section\> semantic Element
+class Section : public Element {
+public:
+    Section() : Element("section"_name) {}
+};
+
+/// \<article\> semantic Element
+class Article : public Element {
+public:
+    Article() : Element("article"_name) {}
+};
+
+/// \<nav\> semantic Element
+class Nav : public Element {
+public:
+    Nav() : Element("nav"_name) {}
+    explicit Nav(const char* apClass) : Element("nav"_name) {
+        cls(apClass);
+    }
+};
+
+/// \<aside\> semantic Element
+class Aside : public Element {
+public:
+    Aside() : Element("aside"_name) {}
+};
+
+/// \<main\> semantic Element
+class Main : public Element {
+public:
+    Main() : Element("main"_name) {}
+};
+
+/// \<figure\> semantic Element
+class Figure : public Element {
+public:
+    Figure() : Element("figure"_name) {}
+};
+
+/// \<figcaption\> semantic Element to use with Figure
+class FigCaption : public Element {
+public:
+    explicit FigCaption(std::string&& aContent) : Element("figcaption"_name, std::move(aContent)) {}
+    explicit FigCaption(const std::string& aContent) : Element("figcaption"_name, aContent) {}
+};
+
+/** @brief \<details\> semantic Element containing detailed information to use with Summary.
+ *
+ * @verbatim
+<details>
+  <summary>Copyright 2017-2018.</summary>
+  <p>By Sebastien Rombauts.</p>
+  <p>sebastien.rombauts@gmail.com.</p>
+</details> @endverbatim
+ */
+class Details : public Element {
+public:
+    explicit Details(const char* apOpen = nullptr) : Element("details"_name) {
+        if (apOpen) {
+            addAttribute("open"_name, apOpen);
+        }
+    }
+};
+
+/// \<summary\> semantic Element to use inside a Details section to specify a visible heading
+class Summary : public Element {
+public:
+    explicit Summary(std::string&& aContent) : Element("summary"_name, std::move(aContent)) {}
+    explicit Summary(const std::string& aContent) : Element("summary"_name, aContent) {}
+};
+
+} // namespace HTML
@@ -0,0 +1,160 @@
+/**
+ * @file    Escape.h
+ * @ingroup HtmlBuilder
+ * @brief   Vectorized escaping of the HTML special characters in text content and attribute values.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Note: the vectorized kernel is selected at compile time from the target instruction set (-mavx2, -msse2, NEON)
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define HTML_ESCAPE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define HTML_ESCAPE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define HTML_ESCAPE_NEON
+#endif
+
+#if defined(_MSC_VER) && (defined(HTML_ESCAPE_AVX2) || defined(HTML_ESCAPE_SSE2))
+#include <intrin.h>
+#endif
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/// Is this one of the characters to escape in HTML text and double-quoted attribute values: & < > "
+inline bool isSpecialChar(const char aChar) {
+    return ('&' == aChar) || ('<' == aChar) || ('>' == aChar) || ('"' == aChar);
+}
+
+/// Character entity replacing a special character
+inline const char* toEntity(const char aChar, size_t& aSize) {
+    switch (aChar) {
+    case '&': aSize = 5; return "&amp;";
+    case '<': aSize = 4; return "&lt;";
+    case '>': aSize = 4; return "&gt;";
+    default:  aSize = 6; return "&quot;";
+    }
+}
+
+#if defined(HTML_ESCAPE_AVX2) || defined(HTML_ESCAPE_SSE2)
+/// Index of the lowest bit set in a non-zero mask
+inline unsigned int lowestBit(const uint32_t aMask) {
+#if defined(_MSC_VER)
+    unsigned long index; // NOLINT(runtime/int) required by the intrinsic
+    _BitScanForward(&index, aMask);
+    return static_cast<unsigned int>(index);
+#else
+    return static_cast<unsigned int>(__builtin_ctz(aMask));
+#endif
+}
+#endif
+
+/**
+ * @brief Find the first special character to escape, scanning 16 or 32 bytes at a time.
+ *
+ * @return pointer to the first special character, or apEnd if there is none
+ */
+inline const char* findSpecialChar(const char* apBegin, const char* const apEnd) {
+#if defined(HTML_ESCAPE_AVX2)
+    const __m256i amp = _mm256_set1_epi8('&');
+    const __m256i lt = _mm256_set1_epi8('<');
+    const __m256i gt = _mm256_set1_epi8('>');
+    const __m256i quot = _mm256_set1_epi8('"');
+    for (; apEnd - apBegin >= 32; apBegin += 32) {
+        const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(apBegin));
+        const __m256i found = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, amp), _mm256_cmpeq_epi8(chunk, lt)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, gt), _mm256_cmpeq_epi8(chunk, quot)));
+        const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(found));
+        if (mask) {
+            return apBegin + lowestBit(mask);
+        }
+    }
+#elif defined(HTML_ESCAPE_SSE2)
+    const __m128i amp = _mm_set1_epi8('&');
+    const __m128i lt = _mm_set1_epi8('<');
+    const __m128i gt = _mm_set1_epi8('>');
+    const __m128i quot = _mm_set1_epi8('"');
+    for (; apEnd - apBegin >= 16; apBegin += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(apBegin));
+        const __m128i found = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, amp), _mm_cmpeq_epi8(chunk, lt)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, gt), _mm_cmpeq_epi8(chunk, quot)));
+        const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(found));
+        if (mask) {
+            return apBegin + lowestBit(mask);
+        }
+    }
+#elif defined(HTML_ESCAPE_NEON)
+    const uint8x16_t amp = vdupq_n_u8('&');
+    const uint8x16_t lt = vdupq_n_u8('<');
+    const uint8x16_t gt = vdupq_n_u8('>');
+    const uint8x16_t quot = vdupq_n_u8('"');
+    for (; apEnd - apBegin >= 16; apBegin += 16) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(apBegin));
+        const uint8x16_t found = vorrq_u8(vorrq_u8(vceqq_u8(chunk, amp), vceqq_u8(chunk, lt)),
+                                          vorrq_u8(vceqq_u8(chunk, gt), vceqq_u8(chunk, quot)));
+        // Narrow each byte of the comparison to 4 bits to get a 64 bits mask
+        const uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(found), 4)), 0);
+        if (mask) {
+            break; // the scalar loop below locates the special character within these 16 bytes
+        }
+    }
+#endif
+    // Scalar fallback, also used for the last bytes
+    for (; apBegin < apEnd; ++apBegin) {
+        if (isSpecialChar(*apBegin)) {
+            break;
+        }
+    }
+    return apBegin;
+}
+
+/**
+ * @brief Append a text with its special characters & < > " replaced by character entities.
+ *
+ *   A text without any special character costs a vectorized scan and a single append.
+ *
+ * @param[in,out] aOutput   Any Output with the std::string append interface (std::string or SizeCounter)
+ * @param[in]     apData    Text to escape
+ * @param[in]     aSize     Length of the text
+ */
+template<typename Output>
+void appendEscaped(Output& aOutput, const char* apData, const size_t aSize) {
+    const char* const pEnd = apData + aSize;
+    for (;;) {
+        const char* pSpecial = findSpecialChar(apData, pEnd);
+        if (pSpecial != apData) {
+            aOutput.append(apData, static_cast<size_t>(pSpecial - apData));
+        }
+        if (pSpecial == pEnd) {
+            break;
+        }
+        size_t size;
+        const char* pEntity = toEntity(*pSpecial, size);
+        aOutput.append(pEntity, size);
+        apData = pSpecial + 1;
+    }
+}
+
+/// Escape a text into a new string
+inline std::string escape(const std::string& aText) {
+    std::string escaped;
+    escaped.reserve(aText.size());
+    appendEscaped(escaped, aText.data(), aText.size());
+    return escaped;
+}
+
+} // namespace HTML
@@ -0,0 +1,422 @@
+/**
+ * @file    FlatDocument.h
+ * @ingroup HtmlBuilder
+ * @brief   Document storing all its nodes in one contiguous array, rendered by an iterative loop.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Document.h"
+
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Alternative to the Document, storing its nodes in one array linked by indices, and their strings in a pool.
+ *
+ *   The Elements built with the usual classes are flattened when appended, so the whole tree lives in a few
+ * contiguous blocks instead of a heap block per Element. A Node handle appends children directly into the array,
+ * so a large list of children never exists as Elements. The serialization is an iterative loop following the
+ * first child, next sibling and parent indices: a deep tree cannot overflow the stack.
+ * The output is identical to the one of the equivalent Document.
+ *
+ * @code
+    HTML::FlatDocument document("Welcome");
+    document.addAttribute("lang", "en");
+    HTML::FlatDocument::Node table = document.body().add(HTML::Table().cls("table"));
+    for (const auto& record : records) {
+        table << (HTML::Row() << HTML::Col(record.mName) << HTML::Col(record.mValue));
+    }
+    send(document.toString());
+ * @endcode
+ */
+class FlatDocument {
+public:
+    /// Handle to a node of a FlatDocument, to append attributes and children like to an Element
+    class Node {
+    public:
+        /// Flatten an Element and its children as the last child of the node
+        Node& operator<<(Element&& aElement) {
+            add(std::move(aElement));
+            return *this;
+        }
+        /// Append a Text child
+        Node& operator<<(std::string aContent) {
+            mpDocument->addChild(mIndex, Text(std::move(aContent)));
+            return *this;
+        }
+        Node& operator<<(const char* apContent) {
+            mpDocument->addChild(mIndex, Text(apContent));
+            return *this;
+        }
+
+        /// Flatten an Element and its children as the last child of the node, and get a handle to it
+        Node add(Element&& aElement) {
+            return Node(*mpDocument, mpDocument->addChild(mIndex, std::move(aElement)));
+        }
+
+        Node& addAttribute(const Name& aName, std::string aValue) {
+            mpDocument->addAttribute(mIndex, aName, std::move(aValue));
+            return *this;
+        }
+        Node& id(std::string aValue) {
+            return addAttribute("id"_name, std::move(aValue));
+        }
+        Node& cls(std::string aValue) {
+            return addAttribute("class"_name, std::move(aValue));
+        }
+
+    private:
+        friend class FlatDocument;
+
+        Node(FlatDocument& aDocument, const uint32_t aIndex) : mpDocument(&aDocument), mIndex(aIndex) {}
+
+    private:
+        FlatDocument*   mpDocument;
+        uint32_t        mIndex;     ///< Index of the node in the array of the FlatDocument
+    };
+
+    FlatDocument() {
+        mNodes.push_back(FlatNode("html"_name));
+        mNodes.push_back(FlatNode("head"_name));
+        mNodes.push_back(FlatNode("body"_name));
+        link(Html, Head);
+        link(Html, Body);
+    }
+    explicit FlatDocument(std::string aTitle) : FlatDocument() {
+        head() << Title(std::move(aTitle));
+    }
+    FlatDocument(std::string aTitle, Style&& aStyle) : FlatDocument(std::move(aTitle)) {
+        head() << std::move(aStyle);
+    }
+
+    /// Flatten a whole Document
+    explicit FlatDocument(const Document& aDocument) : FlatDocument() {
+        const Element& html = aDocument;
+        copyAttributes(Html, html);
+        copy(Head, html.mChildren[0]);
+        copy(Body, html.mChildren[1]);
+    }
+
+    FlatDocument& operator<<(Element&& aElement) {
+        body() << std::move(aElement);
+        return *this;
+    }
+
+    /// Add an attribute to the root \<html\> Element
+    FlatDocument& addAttribute(const Name& aName, std::string aValue) {
+        addAttribute(Html, aName, std::move(aValue));
+        return *this;
+    }
+
+    Node head() {
+        return Node(*this, Head);
+    }
+    Node body() {
+        return Node(*this, Body);
+    }
+
+    /// Reserve room for aNbNodes more nodes and aNbBytes more characters of strings, when known up front
+    void reserve(const size_t aNbNodes, const size_t aNbBytes) {
+        mNodes.reserve(mNodes.size() + aNbNodes);
+        mStrings.reserve(mStrings.size() + aNbBytes);
+    }
+
+    /// Number of nodes, \<html\>, \<head\> and \<body\> included
+    size_t size() const {
+        return mNodes.size();
+    }
+
+    friend std::ostream& operator<< (std::ostream& aStream, const FlatDocument& aDocument);
+
+    /// Serialize the whole Document, with the Pretty layout by default, or the Minified one
+    template<typename Layout = Pretty>
+    std::string toString() const {
+        std::string buffer;
+        buffer.reserve(renderedSize<Layout>());
+        appendTo<Layout>(buffer);
+        return buffer;
+    }
+    /// Serialize the whole Document, with a layout selected at runtime
+    std::string toString(const Format aFormat) const {
+        return (Format::Minified == aFormat) ? toString<Minified>() : toString<Pretty>();
+    }
+
+    /**
+     * @brief Serialize the whole Document, starting with its \<!DOCTYPE\>, at the end of a caller-owned buffer.
+     *
+     * @tparam        Layout    Layout policy, Pretty or Minified
+     * @param[in,out] aBuffer   Buffer to append the generated HTML to, or any Output like a VectoredOutput
+     *
+     * @return the buffer, to chain calls
+     */
+    template<typename Layout = Pretty, typename Output>
+    Output& appendTo(Output& aBuffer) const {
+        render<Layout>(aBuffer);
+        return aBuffer;
+    }
+    template<typename Output>
+    Output& appendTo(Output& aBuffer, const Format aFormat) const {
+        return (Format::Minified == aFormat) ? appendTo<Minified>(aBuffer) : appendTo<Pretty>(aBuffer);
+    }
+
+    /// Compute the exact number of characters that appendTo() would generate, \<!DOCTYPE\> included.
+    template<typename Layout = Pretty>
+    size_t renderedSize() const {
+        SizeCounter counter;
+        render<Layout>(counter);
+        return counter.size();
+    }
+    size_t renderedSize(const Format aFormat) const {
+        return (Format::Minified == aFormat) ? renderedSize<Minified>() : renderedSize<Pretty>();
+    }
+
+private:
+    /// Index of no node, or of no attribute
+    static const uint32_t None = UINT32_MAX;
+    /// Fixed indices of the first nodes
+    static const uint32_t Html = 0;
+    static const uint32_t Head = 1;
+    static const uint32_t Body = 2;
+
+    /// Range of characters in the pool of strings
+    struct StringRef {
+        uint32_t    mOffset;
+        uint32_t    mSize;
+    };
+
+    struct FlatAttribute {
+        Name        mName;
+        StringRef   mValue;
+        uint32_t    mNext;          ///< Next attribute of the same node
+    };
+
+    struct FlatNode {
+        explicit FlatNode(const Name& aName) : mName(aName) {}
+
+        Name        mName;
+        StringRef   mContent{0, 0};
+        uint32_t    mFirstAttribute = None;
+        uint32_t    mLastAttribute = None;
+        uint32_t    mParent = None;
+        uint32_t    mFirstChild = None;
+        uint32_t    mLastChild = None;
+        uint32_t    mNextSibling = None;
+        uint32_t    mRenderable = None;     ///< Index in mRenderables of the content replacing the whole node
+        bool        mbVoid = false;
+        bool        mbRaw = false;
+    };
+
+    /// Index of the next node, or of the next attribute, checked to fit the 32 bits links
+    static uint32_t nextIndex(const size_t aSize) {
+        if (aSize >= None) {
+            throw std::length_error("HTML::FlatDocument size");
+        }
+        return static_cast<uint32_t>(aSize);
+    }
+
+    StringRef addString(const std::string& aString) {
+        const StringRef ref{nextIndex(mStrings.size()), nextIndex(aString.size())};
+        nextIndex(mStrings.size() + aString.size());
+        mStrings += aString;
+        return ref;
+    }
+
+    void link(const uint32_t aParent, const uint32_t aChild) {
+        FlatNode& parent = mNodes[aParent];
+        mNodes[aChild].mParent = aParent;
+        if (None == parent.mLastChild) {
+            parent.mFirstChild = aChild;
+        } else {
+            mNodes[parent.mLastChild].mNextSibling = aChild;
+        }
+        parent.mLastChild = aChild;
+    }
+
+    void addAttribute(const uint32_t aNode, const Name& aName, const std::string& aValue) {
+        const uint32_t index = nextIndex(mAttributes.size());
+        mAttributes.push_back(FlatAttribute{aName, addString(aValue), None});
+        FlatNode& node = mNodes[aNode];
+        if (None == node.mLastAttribute) {
+            node.mFirstAttribute = index;
+        } else {
+            mAttributes[node.mLastAttribute].mNext = index;
+        }
+        node.mLastAttribute = index;
+    }
+
+    /// Flatten an Element and its children in depth-first order, without recursion, as the last child of aParent
+    uint32_t addChild(const uint32_t aParent, const Element& aElement) {
+        struct Frame {
+            const Element*  mpElement;
+            uint32_t        mNode;      ///< Node of the Element
+            size_t          mNext;      ///< Index of the next child to flatten
+        };
+        const uint32_t index = addNode(aParent, aElement);
+        std::vector<Frame> frames;
+        if (hasChildren(aElement)) {
+            frames.push_back(Frame{&aElement, index, 0});
+        }
+        while (!frames.empty()) {
+            Frame& frame = frames.back();
+            if (frame.mNext < frame.mpElement->mChildren.size()) {
+                const Element& child = frame.mpElement->mChildren[frame.mNext++];
+                const uint32_t node = addNode(frame.mNode, child);
+                if (hasChildren(child)) {
+                    frames.push_back(Frame{&child, node, 0});
+                }
+            } else {
+                frames.pop_back();
+            }
+        }
+        return index;
+    }
+
+    /// Children rendered by Element::render(): those of a named Element without Renderable content
+    static bool hasChildren(const Element& aElement) {
+        return !aElement.mpRenderable && !aElement.mName.empty() && !aElement.mChildren.empty();
+    }
+
+    void copyAttributes(const uint32_t aNode, const Element& aElement) {
+        for (const auto& attr : aElement.mAttributes) {
+            addAttribute(aNode, attr.Name, attr.Value);
+        }
+    }
+    /// Flatten the attributes and the children of an Element into an existing node
+    void copy(const uint32_t aNode, const Element& aElement) {
+        copyAttributes(aNode, aElement);
+        for (const auto& child : aElement.mChildren) {
+            addChild(aNode, child);
+        }
+    }
+
+    /// Flatten an Element, without its children
+    uint32_t addNode(const uint32_t aParent, const Element& aElement) {
+        const uint32_t index = nextIndex(mNodes.size());
+        mNodes.push_back(FlatNode(aElement.mName));
+        link(aParent, index);
+        if (aElement.mpRenderable) {
+            mNodes[index].mRenderable = nextIndex(mRenderables.size());
+            mRenderables.push_back(aElement.mpRenderable);
+            return index;
+        }
+        mNodes[index].mContent = addString(aElement.mContent);
+        mNodes[index].mbVoid = aElement.mbVoid;
+        mNodes[index].mbRaw = aElement.mbRaw;
+        copyAttributes(index, aElement);
+        return index;
+    }
+
+    template<typename Layout, typename Output>
+    void render(Output& aBuffer) const {
+        Element::append(aBuffer, "<!DOCTYPE html>");
+        Layout::endline(aBuffer);
+        uint32_t index = Html;
+        size_t indentation = 0;
+        for (;;) {
+            const FlatNode& node = mNodes[index];
+            if (renderOpen<Layout>(aBuffer, node, indentation)) {
+                index = node.mFirstChild;
+                indentation += Layout::Indentation;
+                continue;
+            }
+            // Close the parents of the last children, up to the next sibling
+            while (None == mNodes[index].mNextSibling) {
+                index = mNodes[index].mParent;
+                if (None == index) {
+                    return;
+                }
+                indentation -= Layout::Indentation;
+                renderClose<Layout>(aBuffer, mNodes[index], indentation);
+            }
+            index = mNodes[index].mNextSibling;
+        }
+    }
+
+    /// Serialize a node like Element::render(), up to its children if any: return true to render them next
+    template<typename Layout, typename Output>
+    bool renderOpen(Output& aBuffer, const FlatNode& aNode, const size_t aIndentation) const {
+        if (None != aNode.mRenderable) {
+            OutputWriter<Layout, Output> writer(aBuffer, aIndentation);
+            mRenderables[aNode.mRenderable]->render(writer, aIndentation);
+            return false;
+        }
+        if (aNode.mName.empty()) {
+            Layout::indent(aBuffer, aIndentation);
+            renderText(aBuffer, aNode);
+            Layout::endline(aBuffer);
+            return false;
+        }
+        Layout::indent(aBuffer, aIndentation);
+        aBuffer += '<';
+        aBuffer.append(aNode.mName.data(), aNode.mName.size());
+        for (uint32_t attr = aNode.mFirstAttribute; None != attr; attr = mAttributes[attr].mNext) {
+            const FlatAttribute& attribute = mAttributes[attr];
+            aBuffer += ' ';
+            aBuffer.append(attribute.mName.data(), attribute.mName.size());
+            if (0 < attribute.mValue.mSize) {
+                Element::append(aBuffer, "=\"");
+                appendEscaped(aBuffer, mStrings.data() + attribute.mValue.mOffset, attribute.mValue.mSize);
+                aBuffer += '"';
+            }
+        }
+        if ((0 == aNode.mContent.mSize) && ((None != aNode.mFirstChild) || aNode.mbVoid)) {
+            Layout::tagEndline(aBuffer);
+        } else {
+            aBuffer += '>';
+        }
+        renderText(aBuffer, aNode);
+        if (None != aNode.mFirstChild) {
+            return true;
+        }
+        renderClose<Layout>(aBuffer, aNode, aIndentation);
+        return false;
+    }
+
+    /// Serialize the closing tag of a node like Element::toStringClose()
+    template<typename Layout, typename Output>
+    static void renderClose(Output& aBuffer, const FlatNode& aNode, const size_t aIndentation) {
+        if (None != aNode.mFirstChild) {
+            Layout::indent(aBuffer, aIndentation);
+        }
+        if ((0 < aNode.mContent.mSize) || (None != aNode.mFirstChild) || !aNode.mbVoid) {
+            Element::append(aBuffer, "</");
+            aBuffer.append(aNode.mName.data(), aNode.mName.size());
+            Layout::tagEndline(aBuffer);
+        }
+    }
+
+    template<typename Output>
+    void renderText(Output& aBuffer, const FlatNode& aNode) const {
+        if (aNode.mbRaw) {
+            aBuffer.append(mStrings.data() + aNode.mContent.mOffset, aNode.mContent.mSize);
+        } else {
+            appendEscaped(aBuffer, mStrings.data() + aNode.mContent.mOffset, aNode.mContent.mSize);
+        }
+    }
+
+private:
+    std::vector<FlatNode>                           mNodes;         ///< All the nodes, \<html\> first
+    std::vector<FlatAttribute>                      mAttributes;    ///< Attributes of all the nodes
+    std::string                                     mStrings;       ///< Pool of the contents and attribute values
+    std::vector<std::shared_ptr<const Renderable>>  mRenderables;   ///< Contents generated by custom code
+};
+
+inline std::ostream& operator<< (std::ostream& aStream, const FlatDocument& aDocument) {
+    const std::string buffer = aDocument.toString();
+    return aStream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+} // namespace HTML
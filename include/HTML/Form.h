@@ -0,0 +1,289 @@
+/**
+ * @file    Form.h
+ * @ingroup HtmlBuilder
+ * @brief   Elements of a \<form\>: inputs of all types, text areas and selections.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Element.h"
+
+#include <string>
+#include <utility>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/// \<form\> Element
+class Form : public Element {
+public:
+    explicit Form(const char* apAction = nullptr, const char* apMethod = nullptr) : Element("form"_name) {
+        if (apAction) {
+            addAttribute("action"_name, apAction);
+        }
+        if (apMethod) {
+            addAttribute("method"_name, apMethod);
+        }
+    }
+};
+
+/// \<input\> Element to use in Form
+class Input : public Element {
+public:
+    explicit Input(const char* apType = nullptr, const char* apName = nullptr,
+                   const char* apValue = nullptr, const char* apContent = nullptr) : Element("input"_name, apContent) {
+        if (apType) {
+            addAttribute("type"_name, apType);
+        }
+        if (apName) {
+            addAttribute("name"_name, apName);
+        }
+        if (apValue) {
+            addAttribute("value"_name, apValue);
+        }
+        mbVoid = true;
+    }
+
+    Input&& addAttribute(const Name& aName, std::string&& aValue) {
+        Element::addAttribute(aName, std::move(aValue));
+        return std::move(*this);
+    }
+    Input&& addAttribute(const Name& aName, const std::string& aValue) {
+        Element::addAttribute(aName, aValue);
+        return std::move(*this);
+    }
+    template<typename T, typename = typename std::enable_if<IsNumber<T>::value>::type>
+    Input&& addAttribute(const Name& aName, const T aValue) {
+        Element::addAttribute(aName, aValue);
+        return std::move(*this);
+    }
+    Input&& addAttribute(const Name& aName, const double aValue, const FloatFormat aFormat) {
+        Element::addAttribute(aName, aValue, aFormat);
+        return std::move(*this);
+    }
+
+    Input&& id(std::string aValue) {
+        return addAttribute("id"_name, std::move(aValue));
+    }
+    Input&& cls(std::string aValue) {
+        return addAttribute("class"_name, std::move(aValue));
+    }
+    Input&& title(std::string aValue) {
+        return addAttribute("title"_name, std::move(aValue));
+    }
+    Input&& style(std::string aValue) {
+        return addAttribute("style"_name, std::move(aValue));
+    }
+
+    Input&& size(const unsigned int aSize) {
+        return addAttribute("size"_name, aSize);
+    }
+    Input&& maxlength(const unsigned int aMaxlength) {
+        return addAttribute("maxlength"_name, aMaxlength);
+    }
+    Input&& placeholder(std::string aPlaceholder) {
+        return addAttribute("placeholder"_name, std::move(aPlaceholder));
+    }
+    Input&& min(std::string aMin) {
+        return addAttribute("min"_name, std::move(aMin));
+    }
+    Input&& min(const unsigned int aMin) {
+        return addAttribute("min"_name, aMin);
+    }
+    Input&& max(std::string aMax) { // NOLINT(build/include_what_you_use) false positive
+        return addAttribute("max"_name, std::move(aMax));
+    }
+    Input&& max(const unsigned int aMax) { // NOLINT(build/include_what_you_use) false positive
+        return addAttribute("max"_name, aMax);
+    }
+
+    Input&& checked(const bool abChecked = true) {
+        if (abChecked) {
+            addAttribute("checked"_name, "");
+        }
+        return std::move(*this);
+    }
+    Input&& autocomplete() {
+        return addAttribute("autocomplete"_name, "");
+    }
+    Input&& autofocus() {
+        return addAttribute("autofocus"_name, "");
+    }
+    Input&& disabled() {
+        return addAttribute("disabled"_name, "");
+    }
+    Input&& readonly() {
+        return addAttribute("readonly"_name, "");
+    }
+    Input&& required() {
+        return addAttribute("required"_name, "");
+    }
+};
+
+/// \<input\> Radio Element to use in Form
+class InputRadio : public Input {
+public:
+    explicit InputRadio(const char* apName, const char* apValue = nullptr, const char* apContent = nullptr) :
+        Input("radio", apName, apValue, apContent) {
+    }
+};
+
+/// \<input\> Checkbox Element to use in Form
+class InputCheckbox : public Input {
+public:
+    explicit InputCheckbox(const char* apName, const char* apValue = nullptr, const char* apContent = nullptr) :
+        Input("checkbox", apName, apValue, apContent) {
+    }
+};
+
+/// \<input\> hidden Element to use in Form
+class InputHidden : public Input {
+public:
+    explicit InputHidden(const char* apName, const char* apValue = nullptr) :
+        Input("hidden", apName, apValue) {
+    }
+};
+
+/// \<input\> text Element to use in Form
+class InputText : public Input {
+public:
+    explicit InputText(const char* apName, const char* apValue = nullptr) :
+        Input("text", apName, apValue) {
+    }
+};
+
+/// \<textarea\> Element to use in Form
+class TextArea : public Element {
+public:
+    explicit TextArea(const char* apName, const unsigned int aCols = 0, const unsigned int aRows = 0) :
+        Element("textarea"_name) {
+        addAttribute("name"_name, apName);
+        if (0 < aCols) {
+            addAttribute("cols"_name, aCols);
+        }
+        if (0 < aRows) {
+            addAttribute("rows"_name, aRows);
+        }
+    }
+    TextArea&& maxlength(const unsigned int aMaxlength) {
+        addAttribute("maxlength"_name, aMaxlength);
+        return std::move(*this);
+    }
+};
+
+/// \<intput\> Number Element to use in Form
+class InputNumber : public Input {
+public:
+    explicit InputNumber(const char* apName, const char* apValue = nullptr) :
+        Input("number", apName, apValue) {
+    }
+};
+
+/// \<intput\> Range Element to use in Form
+class InputRange : public Input {
+public:
+    explicit InputRange(const char* apName, const char* apValue = nullptr) :
+        Input("range", apName, apValue) {
+    }
+};
+
+/// \<intput\> Date Element to use in Form
+class InputDate : public Input {
+public:
+    explicit InputDate(const char* apName, const char* apValue = nullptr) :
+        Input("date", apName, apValue) {
+    }
+};
+
+/// \<intput\> Time Element to use in Form
+class InputTime : public Input {
+public:
+    explicit InputTime(const char* apName, const char* apValue = nullptr) :
+        Input("time", apName, apValue) {
+    }
+};
+
+/// \<intput\> E-mail Element to use in Form
+class InputEmail : public Input {
+public:
+    explicit InputEmail(const char* apName, const char* apValue = nullptr) :
+        Input("email", apName, apValue) {
+    }
+};
+
+/// \<intput\> URL Element to use in Form
+class InputUrl : public Input {
+public:
+    explicit InputUrl(const char* apName, const char* apValue = nullptr) :
+        Input("url", apName, apValue) {
+    }
+};
+
+/// \<intput\> Password Element to use in Form
+class InputPassword : public Input {
+public:
+    explicit InputPassword(const char* apName) :
+        Input("password", apName) {
+    }
+};
+
+/// \<intput\> Submit Button Element to use in Form
+class InputSubmit : public Input {
+public:
+    explicit InputSubmit(const char* apValue = nullptr, const char* apName = nullptr) :
+        Input("submit", apName, apValue) {
+    }
+};
+
+/// \<intput\> Reset Button Element to use in Form
+class InputReset : public Input {
+public:
+    explicit InputReset(const char* apValue = nullptr) :
+        Input("reset", nullptr, apValue) {
+    }
+};
+
+/// \<intput\> List Element to use in Form with DataList
+class InputList : public Input {
+public:
+    explicit InputList(const char* apName, const char* apList) : Input(nullptr, apName) {
+        addAttribute("list"_name, apList);
+    }
+};
+
+/// \<datalist\> Element for InputList, to use with Option Elements
+class DataList : public Element {
+public:
+    explicit DataList(const char* apId) : Element("datalist"_name) {
+        addAttribute("id"_name, apId);
+    }
+};
+
+/// \<select\> Element to use with Option Elements
+class Select : public Element {
+public:
+    explicit Select(const char* apName) : Element("select"_name) {
+        addAttribute("name"_name, apName);
+    }
+};
+
+/// \<option\> Element for Select and DataList
+class Option : public Element {
+public:
+    explicit Option(const char* apValue, const char* apContent = nullptr) : Element("option"_name, apContent) {
+        addAttribute("value"_name, apValue);
+    }
+
+    Option&& selected(const bool abSelected = true) {
+        if (abSelected) {
+            addAttribute("selected"_name, "");
+        }
+        return std::move(*this);
+    }
+};
+
+} // namespace HTML
@@ -0,0 +1,131 @@
+/**
+ * @file    Fwd.h
+ * @ingroup HtmlBuilder
+ * @brief   Forward declarations of the classes of the library, for the headers only passing them by reference.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+// Layout.h
+enum class Format;
+struct Pretty;
+struct Minified;
+
+// Name.h, Number.h
+class Name;
+class Number;
+struct FloatFormat;
+
+// Element.h
+class SizeCounter;
+class Writer;
+class Renderable;
+class Element;
+class Empty;
+class Text;
+class Raw;
+class Slot;
+class Fragment;
+class Shared;
+
+// Head.h
+class Title;
+class Style;
+class Script;
+class Meta;
+class Rel;
+class Base;
+class Head;
+class Body;
+
+// Table.h
+class ColHeader;
+class Col;
+class Row;
+class Caption;
+class Table;
+
+// Form.h
+class Form;
+class Input;
+class InputRadio;
+class InputCheckbox;
+class InputHidden;
+class InputText;
+class TextArea;
+class InputNumber;
+class InputRange;
+class InputDate;
+class InputTime;
+class InputEmail;
+class InputUrl;
+class InputPassword;
+class InputSubmit;
+class InputReset;
+class InputList;
+class DataList;
+class Select;
+class Option;
+
+// Elements.h
+class Break;
+class ListItem;
+class List;
+class Header1;
+class Header2;
+class Header3;
+class Bold;
+class Italic;
+class Small;
+class Strong;
+class Paragraph;
+class Div;
+class Span;
+class Pre;
+class Link;
+class Image;
+class Progress;
+class Meter;
+class Mark;
+class Time;
+class Header;
+class Footer;
+class Section;
+class Article;
+class Nav;
+class Aside;
+class Main;
+class Figure;
+class FigCaption;
+class Details;
+class Summary;
+
+// Document.h and the other ways to build and serialize the HTML
+class Document;
+class DocumentPool;
+class PooledDocument;
+class FlatDocument;
+class DataTable;
+class Deferred;
+class Template;
+struct Patch;
+class Diff;
+class Sink;
+class StreamWriter;
+class ChunkedWriter;
+class VectoredOutput;
+class ContentHash;
+class HashingOutput;
+class HashingSink;
+struct ParallelPolicy;
+struct RenderStats;
+class RenderObserver;
+
+} // namespace HTML
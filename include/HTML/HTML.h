@@ -16,4 +16,19 @@
  */
 
 #include "Element.h"
+#include "Head.h"
+#include "Table.h"
+#include "Form.h"
+#include "Elements.h"
 #include "Document.h"
+#include "DocumentPool.h"
+#include "FlatDocument.h"
+#include "DataTable.h"
+#include "Deferred.h"
+#include "Template.h"
+#include "Diff.h"
+#include "StreamWriter.h"
+#include "ChunkedWriter.h"
+#include "VectoredOutput.h"
+#include "Compression.h"
+#include "Hash.h"
@@ -0,0 +1,282 @@
+/**
+ * @file    Hash.h
+ * @ingroup HtmlBuilder
+ * @brief   Hash of the generated HTML computed while it is written, for the ETag of the HTTP caching.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Sink.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief 64-bit xxHash (XXH64) of the generated HTML, computed incrementally: a fast non-cryptographic hash.
+ *
+ *   The hash only depends on the bytes, not on the way they are split into chunks, so it is the same
+ * whether the HTML is hashed as one string or as it is written. Like a SizeCounter, a ContentHash mimics
+ * the std::string append interface: any Element or Document can be hashed without generating its HTML in memory.
+ *
+ * @code
+    HTML::ContentHash hash;
+    document.appendTo<HTML::Minified>(hash);
+    if (request.header("If-None-Match") == hash.etag()) {
+        return reply(304); // Not Modified, without rendering the page
+    }
+ * @endcode
+ */
+class ContentHash {
+public:
+    explicit ContentHash(const uint64_t aSeed = 0) : mSeed(aSeed) {
+        mAccumulators[0] = aSeed + Prime1 + Prime2;
+        mAccumulators[1] = aSeed + Prime2;
+        mAccumulators[2] = aSeed;
+        mAccumulators[3] = aSeed - Prime1;
+    }
+
+    ContentHash& append(const char* apData, size_t aSize) {
+        mSize += aSize;
+        if (mBuffered + aSize < StripeSize) {
+            memcpy(mBuffer + mBuffered, apData, aSize);
+            mBuffered += aSize;
+            return *this;
+        }
+        if (mBuffered > 0) {
+            const size_t missing = StripeSize - mBuffered;
+            memcpy(mBuffer + mBuffered, apData, missing);
+            consume(mBuffer);
+            apData += missing;
+            aSize -= missing;
+            mBuffered = 0;
+        }
+        for (; aSize >= StripeSize; apData += StripeSize, aSize -= StripeSize) {
+            consume(apData);
+        }
+        memcpy(mBuffer, apData, aSize);
+        mBuffered = aSize;
+        return *this;
+    }
+    /// Hash the indentation
+    ContentHash& append(size_t aCount, const char aChar) {
+        char chars[StripeSize];
+        memset(chars, aChar, sizeof(chars));
+        // Note: at most the rest of the current stripe at a time, so that the chars always fit in the buffer
+        while (aCount > 0) {
+            const size_t size = std::min(aCount, StripeSize - mBuffered);
+            append(chars, size);
+            aCount -= size;
+        }
+        return *this;
+    }
+    ContentHash& operator+=(const char aChar) {
+        return append(&aChar, 1);
+    }
+    ContentHash& operator+=(const std::string& aString) {
+        return append(aString.data(), aString.size());
+    }
+
+    /// Number of bytes hashed
+    size_t size() const {
+        return mSize;
+    }
+
+    /// Hash of the bytes given so far; more bytes can be appended afterward
+    uint64_t digest() const {
+        uint64_t hash;
+        if (mSize >= StripeSize) {
+            hash = rotate(mAccumulators[0], 1) + rotate(mAccumulators[1], 7) +
+                   rotate(mAccumulators[2], 12) + rotate(mAccumulators[3], 18);
+            for (const uint64_t accumulator : mAccumulators) {
+                hash = (hash ^ round(0, accumulator)) * Prime1 + Prime4;
+            }
+        } else {
+            hash = mSeed + Prime5;
+        }
+        hash += static_cast<uint64_t>(mSize);
+
+        const char* pData = mBuffer;
+        size_t size = mBuffered;
+        for (; size >= 8; pData += 8, size -= 8) {
+            hash = rotate(hash ^ round(0, read64(pData)), 27) * Prime1 + Prime4;
+        }
+        if (size >= 4) {
+            hash = rotate(hash ^ (static_cast<uint64_t>(read32(pData)) * Prime1), 23) * Prime2 + Prime3;
+            pData += 4;
+            size -= 4;
+        }
+        for (; size > 0; ++pData, --size) {
+            hash = rotate(hash ^ (static_cast<uint64_t>(static_cast<unsigned char>(*pData)) * Prime5), 11) * Prime1;
+        }
+
+        hash ^= hash >> 33;
+        hash *= Prime2;
+        hash ^= hash >> 29;
+        hash *= Prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    /// Strong ETag of the bytes given so far: the digest as 16 hexadecimal digits between double quotes
+    std::string etag() const {
+        return toETag(digest());
+    }
+    static std::string toETag(uint64_t aDigest) {
+        static const char digits[] = "0123456789abcdef";
+        std::string etag(18, '"');
+        for (size_t idx = 16; idx > 0; --idx, aDigest >>= 4) {
+            etag[idx] = digits[aDigest & 0xF];
+        }
+        return etag;
+    }
+
+private:
+    static const size_t StripeSize = 32;
+    static const uint64_t Prime1 = 0x9E3779B185EBCA87ULL;
+    static const uint64_t Prime2 = 0xC2B2AE3D27D4EB4FULL;
+    static const uint64_t Prime3 = 0x165667B19E3779F9ULL;
+    static const uint64_t Prime4 = 0x85EBCA77C2B2AE63ULL;
+    static const uint64_t Prime5 = 0x27D4EB2F165667C5ULL;
+
+    /// Mix a stripe of 32 bytes into the four accumulators
+    void consume(const char* apStripe) {
+        for (size_t lane = 0; lane < 4; ++lane) {
+            mAccumulators[lane] = round(mAccumulators[lane], read64(apStripe + lane * 8));
+        }
+    }
+
+    static uint64_t round(uint64_t aAccumulator, const uint64_t aLane) {
+        aAccumulator += aLane * Prime2;
+        return rotate(aAccumulator, 31) * Prime1;
+    }
+    static uint64_t rotate(const uint64_t aValue, const int aBits) {
+        return (aValue << aBits) | (aValue >> (64 - aBits));
+    }
+
+    // Note: xxHash reads the bytes in little-endian order, so the hash is the same on all platforms
+    static uint64_t read64(const char* apData) {
+        uint64_t value;
+        memcpy(&value, apData, sizeof(value));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        value = __builtin_bswap64(value);
+#endif
+        return value;
+    }
+    static uint32_t read32(const char* apData) {
+        uint32_t value;
+        memcpy(&value, apData, sizeof(value));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        value = __builtin_bswap32(value);
+#endif
+        return value;
+    }
+
+private:
+    const uint64_t  mSeed;                  ///< Seed of the hash
+    uint64_t        mAccumulators[4];       ///< State of the four lanes of the stripes
+    char            mBuffer[StripeSize];    ///< Bytes of the incomplete stripe
+    size_t          mBuffered = 0;          ///< Number of bytes of the incomplete stripe
+    size_t          mSize = 0;              ///< Total number of bytes hashed
+};
+
+/**
+ * @brief Output appending the generated HTML to a std::string, hashing it at the same time.
+ *
+ *   The HTML is hashed by blocks of a few KB as soon as they are appended, while they are still in the cache
+ * of the processor, instead of each of the many short strings of the serialization.
+ *
+ * @code
+    std::string html;
+    HTML::HashingOutput output(html);
+    document.appendTo(output);
+    reply.header("ETag", output.hash().etag()).body(html);
+ * @endcode
+ */
+class HashingOutput {
+public:
+    static const size_t BlockSize = 4 * 1024;
+
+    explicit HashingOutput(std::string& aBuffer) : mBuffer(aBuffer), mHashed(aBuffer.size()) {}
+
+    HashingOutput& append(const char* apData, const size_t aSize) {
+        mBuffer.append(apData, aSize);
+        hashIfFull();
+        return *this;
+    }
+    HashingOutput& append(const size_t aCount, const char aChar) {
+        mBuffer.append(aCount, aChar);
+        hashIfFull();
+        return *this;
+    }
+    HashingOutput& operator+=(const char aChar) {
+        mBuffer += aChar;
+        hashIfFull();
+        return *this;
+    }
+    HashingOutput& operator+=(const std::string& aString) {
+        return append(aString.data(), aString.size());
+    }
+
+    /// Hash of the HTML appended through this Output (not of the previous content of the buffer)
+    const ContentHash& hash() {
+        hashBlock();
+        return mHash;
+    }
+
+private:
+    void hashIfFull() {
+        if (mBuffer.size() - mHashed >= BlockSize) {
+            hashBlock();
+        }
+    }
+    void hashBlock() {
+        mHash.append(mBuffer.data() + mHashed, mBuffer.size() - mHashed);
+        mHashed = mBuffer.size();
+    }
+
+private:
+    std::string&    mBuffer;    ///< Buffer of the generated HTML
+    size_t          mHashed;    ///< Size of the buffer already hashed
+    ContentHash     mHash;      ///< Hash of the generated HTML
+};
+
+/**
+ * @brief Sink hashing the generated HTML before forwarding it to another Sink, for instance to log or cache the ETag
+ * of a page written chunk by chunk (StreamWriter, VectoredOutput, before a GzipSink).
+ */
+class HashingSink : public Sink {
+public:
+    explicit HashingSink(Sink& aSink) : mSink(aSink) {}
+
+    void write(const char* apData, size_t aSize) override {
+        mHash.append(apData, aSize);
+        mSink.write(apData, aSize);
+    }
+    void writev(const IoSlice* apSlices, size_t aCount) override {
+        for (size_t idx = 0; idx < aCount; ++idx) {
+            mHash.append(static_cast<const char*>(apSlices[idx].iov_base), apSlices[idx].iov_len);
+        }
+        mSink.writev(apSlices, aCount);
+    }
+
+    /// Hash of the HTML written so far
+    const ContentHash& hash() const {
+        return mHash;
+    }
+
+private:
+    Sink&       mSink;  ///< Destination of the generated HTML
+    ContentHash mHash;  ///< Hash of the generated HTML
+};
+
+} // namespace HTML
@@ -0,0 +1,170 @@
+/**
+ * @file    Head.h
+ * @ingroup HtmlBuilder
+ * @brief   Elements of the \<head\> of a Document (title, style, scripts and metadata), \<head\> and \<body\>.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Element.h"
+
+#include <string>
+#include <utility>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/// \<title\> Element required in \<head\>
+class Title : public Element {
+public:
+    explicit Title(const char* apContent) : Element("title"_name, apContent) {}
+    explicit Title(std::string&& aContent) : Element("title"_name, std::move(aContent)) {}
+    explicit Title(const std::string& aContent) : Element("title"_name, aContent) {}
+};
+
+/// \<style\> Element for inline CSS in \<head\>, written as is without escaping
+class Style : public Element {
+public:
+    explicit Style(const char* apContent) : Element("style"_name, apContent) {
+        mbRaw = true;
+    }
+    explicit Style(std::string&& aContent) : Element("style"_name, std::move(aContent)) {
+        mbRaw = true;
+    }
+    explicit Style(const std::string& aContent) : Element("style"_name, aContent) {
+        mbRaw = true;
+    }
+};
+
+/// \<script\> Element for inline Javascript in \<head\>, written as is without escaping
+class Script : public Element {
+public:
+    Script() : Element("script"_name) {}
+    explicit Script(const char* apSrc) : Element("script"_name) {
+        if (apSrc) {
+            addAttribute("src"_name, apSrc);
+        }
+    }
+    explicit Script(const char* apSrc, const char* apContent) : Element("script"_name, apContent) {
+        mbRaw = true;
+        if (apSrc) {
+            addAttribute("src"_name, apSrc);
+        }
+    }
+    Script&& integrity(std::string aValue) {
+        addAttribute("integrity"_name, std::move(aValue));
+        return std::move(*this);
+    }
+    Script&& crossorigin(std::string aValue) {
+        addAttribute("crossorigin"_name, std::move(aValue));
+        return std::move(*this);
+    }
+};
+
+/// \<meta\> metadata about the Document in \<head\>
+class Meta : public Element {
+public:
+    Meta() : Element("meta"_name) {}
+    explicit Meta(const char* apCharset) : Element("meta"_name) {
+        addAttribute("charset"_name, apCharset);
+        mbVoid = true;
+    }
+    explicit Meta(const char* apName, const char* apContent) : Element("meta"_name) {
+        addAttribute("name"_name, apName);
+        addAttribute("content"_name, apContent);
+        mbVoid = true;
+    }
+};
+
+/// \<link\> Element to reference external CSS or Javascript files
+class Rel : public Element {
+public:
+    Rel(const char* apRel, const char* apUrl, const char* apType = nullptr) : Element("link"_name) {
+        addAttribute("rel"_name, apRel);
+        addAttribute("href"_name, apUrl);
+        if (apType) {
+            addAttribute("type"_name, apType);
+        }
+        mbVoid = true;
+    }
+
+    Rel&& integrity(std::string aValue) {
+        addAttribute("integrity"_name, std::move(aValue));
+        return std::move(*this);
+    }
+    Rel&& crossorigin(std::string aValue) {
+        addAttribute("crossorigin"_name, std::move(aValue));
+        return std::move(*this);
+    }
+};
+
+/// \<base\> Element in \<head\>
+class Base : public Element {
+public:
+    Base(std::string aContent, std::string aUrl, const char* apTarget) : Element("base"_name, std::move(aContent)) {
+        addAttribute("href"_name, std::move(aUrl));
+        if (apTarget) {
+            addAttribute("target"_name, apTarget);
+        }
+    }
+};
+
+/// \<head\> required as the first child Element in every HTML Document
+class Head : public Element {
+public:
+    Head() : Element("head"_name) {}
+
+    Head&& operator<<(Element&& aElement) = delete;
+    Head&& operator<<(Slot&& aSlot) {
+        mChildren.push_back(std::move(aSlot));
+        return std::move(*this);
+    }
+    Head&& operator<<(Title&& aTitle) {
+        mChildren.push_back(std::move(aTitle));
+        return std::move(*this);
+    }
+    Head&& operator<<(Style&& aStyle) {
+        mChildren.push_back(std::move(aStyle));
+        return std::move(*this);
+    }
+    Head&& operator<<(Script&& aScript) {
+        mChildren.push_back(std::move(aScript));
+        return std::move(*this);
+    }
+    Head&& operator<<(Meta&& aMeta) {
+        mChildren.push_back(std::move(aMeta));
+        return std::move(*this);
+    }
+    Head&& operator<<(Rel&& aRel) {
+        mChildren.push_back(std::move(aRel));
+        return std::move(*this);
+    }
+    Head&& operator<<(Base&& aBase) {
+        mChildren.push_back(std::move(aBase));
+        return std::move(*this);
+    }
+    Head&& operator<<(Fragment&& aFragment) {
+        mChildren.push_back(std::move(aFragment));
+        return std::move(*this);
+    }
+    Head&& operator<<(Shared&& aShared) {
+        mChildren.push_back(std::move(aShared));
+        return std::move(*this);
+    }
+};
+
+/// \<body\> required as the second child Element in every HTML Document
+class Body : public Element {
+public:
+    Body() : Element("body"_name) {}
+};
+
+// Constructor of the Root \<html\> Element
+inline Element::Element() : mName("html"_name), mChildren{Head(), Body()} {
+}
+
+} // namespace HTML
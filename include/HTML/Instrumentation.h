@@ -0,0 +1,115 @@
+/**
+ * @file    Instrumentation.h
+ * @ingroup HtmlBuilder
+ * @brief   Opt-in instrumentation of the serialization: statistics of a Document and hooks around each of its phases.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Layout.h"
+#include "Name.h"
+
+#include <cstddef>
+#include <map>
+#include <string>
+
+// Note: the instrumentation used to be enabled by a macro, now replaced by the Observed layout policy
+#if defined(HTML_INSTRUMENTATION)
+#error "HTML_INSTRUMENTATION is no longer supported: serialize with a layout like HTML::Observed<HTML::Pretty>"
+#endif
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Statistics of the serialization of an Element and its children (see Element::renderStats()).
+ *
+ *   Combined with a CountingResource selected while building the Document, they give the cost of a page.
+ */
+struct RenderStats {
+    size_t  mNodes = 0;         ///< Number of Elements, text included
+    size_t  mMaxDepth = 0;      ///< Depth of the deepest Element, the root being at depth 1
+    size_t  mAttributes = 0;    ///< Total number of attributes
+    size_t  mBytes = 0;         ///< Size of the generated HTML
+    /// Size of the HTML generated by the tags, attributes and text of the Elements of each name,
+    /// "#text" for text and "#custom" for the content generated by a Renderable (like a Fragment or a DataTable)
+    std::map<std::string, size_t> mBytesPerTag;
+};
+
+/// Phase of the serialization of an Element, reported to a RenderObserver
+enum class RenderPhase {
+    Open,       ///< Opening tag and attributes
+    Content,    ///< Text and children, or content generated by a Renderable
+    Close       ///< Closing tag
+};
+
+/**
+ * @brief Hooks called around each phase of the serialization of each Element, to export timings for instance.
+ *
+ *   The hooks are only compiled in the serializations with an Observed layout, and only called for the Elements
+ * serialized by the thread of the ScopedObserver (not by the thread pool of a ParallelPolicy),
+ * the phases of the children being nested in the Content phase of their parent.
+ */
+class RenderObserver {
+public:
+    virtual ~RenderObserver() {}
+
+    /// Beginning of a phase of the Element with the given name (empty for text and Renderable content)
+    virtual void onBegin(RenderPhase aPhase, const Name& aName) = 0;
+    /// End of the phase
+    virtual void onEnd(RenderPhase aPhase, const Name& aName) = 0;
+};
+
+/// Get a reference to the RenderObserver of the calling thread, if any
+inline RenderObserver*& currentObserverPtr() {
+    static thread_local RenderObserver* pObserver = nullptr;
+    return pObserver;
+}
+
+/**
+ * @brief RAII guard selecting the RenderObserver called by the serializations of the current thread.
+ *
+ * @code
+    MetricsObserver observer; // calls steady_clock::now() in onBegin() and onEnd()
+    {
+        HTML::ScopedObserver scope(observer);
+        send(document.toString());
+    }
+ * @endcode
+ */
+class ScopedObserver {
+public:
+    explicit ScopedObserver(RenderObserver& aObserver) : mpPrevious(currentObserverPtr()) {
+        currentObserverPtr() = &aObserver;
+    }
+    ~ScopedObserver() {
+        currentObserverPtr() = mpPrevious;
+    }
+
+    ScopedObserver(const ScopedObserver&) = delete;
+    ScopedObserver& operator=(const ScopedObserver&) = delete;
+
+private:
+    RenderObserver* mpPrevious; ///< Observer to restore at the end of the scope
+};
+
+/**
+ * @brief Layout policy calling the RenderObserver of the thread around each phase of the serialization.
+ *
+ *   Any other layout does not even compile the hooks, so only the serializations to observe pay for them.
+ *
+ * @code
+    HTML::ScopedObserver scope(observer);
+    send(document.toString<HTML::Observed<HTML::Pretty>>());
+ * @endcode
+ */
+template<typename Layout>
+struct Observed : public Layout {
+    static const bool IsObserved = true;
+};
+
+} // namespace HTML
@@ -0,0 +1,100 @@
+/**
+ * @file    Layout.h
+ * @ingroup HtmlBuilder
+ * @brief   Layout policies of the generated HTML: Pretty (indented) or Minified.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include <cstddef>
+
+// Note: the layout used to be configured by macros, now replaced by the template parameters of PrettyLayout
+#if defined(HTML_INDENTATION) || defined(HTML_ENDLINE)
+#error "HTML_INDENTATION and HTML_ENDLINE are no longer supported: serialize with a layout like HTML::PrettyLayout<4>"
+#endif
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/// Layout of the generated HTML, selected at runtime (see Element::toString(Format))
+enum class Format {
+    Pretty,     ///< Each Element indented on its own line (see Pretty)
+    Minified    ///< Without any indentation nor end of line (see Minified)
+};
+
+/// End of line of the Pretty layouts
+enum class Endline {
+    LF,     ///< "\n"
+    CRLF    ///< "\r\n"
+};
+
+/**
+ * @brief Pretty layout policy: each Element indented on its own line.
+ *
+ *   A layout policy is the template parameter of the serialization (see Element::toString<Layout>()),
+ * so that each layout is a separate specialization of the code, and a program can use several of them.
+ *
+ * @tparam IndentationT Number of spaces of indentation added for each level of children
+ * @tparam EndlineT     End of line written after each Element
+ *
+ * @code
+    const std::string html = document.toString<HTML::PrettyLayout<4, HTML::Endline::CRLF>>();
+ * @endcode
+ *
+ * @note The content of the Renderables (like a Fragment or a DataTable) is indented by the levels of the layout
+ *       (see Writer::indent()), but the StreamWriter, ChunkedWriter, Template and static HTML select their layout
+ *       with a Format, so always use the default Pretty layout.
+ */
+template<size_t IndentationT = 2, Endline EndlineT = Endline::LF>
+struct PrettyLayout {
+    /// Number of spaces of indentation added for each level of children
+    static const size_t Indentation = IndentationT;
+    /// The RenderObserver is not called (see Observed)
+    static const bool IsObserved = false;
+
+    template<typename Output>
+    static void indent(Output& aOutput, const size_t aIndentation) {
+        aOutput.append(aIndentation, ' ');
+    }
+    template<typename Output>
+    static void endline(Output& aOutput) {
+        if (Endline::CRLF == EndlineT) {
+            aOutput.append("\r\n", 2);
+        } else {
+            aOutput.append("\n", 1);
+        }
+    }
+    /// Closing '>' of a tag followed by an end of line
+    template<typename Output>
+    static void tagEndline(Output& aOutput) {
+        if (Endline::CRLF == EndlineT) {
+            aOutput.append(">\r\n", 3);
+        } else {
+            aOutput.append(">\n", 2);
+        }
+    }
+};
+
+/// Default Pretty layout, indented by 2 spaces with "\n" ends of line, the one selected by Format::Pretty
+struct Pretty : public PrettyLayout<> {};
+
+/// Minified layout policy: no indentation loop and no end of line write at all
+struct Minified {
+    static const size_t Indentation = 0;
+    static const bool IsObserved = false;
+
+    template<typename Output>
+    static void indent(Output&, size_t) {}
+    template<typename Output>
+    static void endline(Output&) {}
+    template<typename Output>
+    static void tagEndline(Output& aOutput) {
+        aOutput += '>';
+    }
+};
+
+} // namespace HTML
@@ -0,0 +1,164 @@
+/**
+ * @file    Name.h
+ * @ingroup HtmlBuilder
+ * @brief   Name of an Element tag or of an Attribute, pointing to a string literal or to reference counted storage.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Name of an Element tag or of an Attribute, like "td", "class" or "href".
+ *
+ *   A Name built from a string literal with the _name suffix just points to it, without any copy nor allocation:
+ * this is how all the Elements of the library name their tags and attributes. Any other name (C-string, char buffer,
+ * std::string) is copied once into a reference counted block shared by the copies of the Name, and freed with
+ * the last one, so a Name never refers to the storage of its argument.
+ *
+ * @code
+    using namespace HTML::literals;
+    HTML::Element("custom-element"_name).addAttribute("data-id"_name, "42");
+ * @endcode
+ */
+class Name {
+public:
+    /// Empty name, used by Text Elements
+    Name() : mpData(""), mSize(0), mbShared(false) {}
+
+    /// Name from a runtime C-string or char buffer: copied up to its NUL terminator
+    template<typename T, typename = typename std::enable_if<std::is_convertible<T, const char*>::value>::type>
+    Name(const T apName) : Name() { // NOLINT(runtime/explicit)
+        const char* pName = apName;
+        if (pName) {
+            copy(pName, strlen(pName));
+        }
+    }
+
+    /// Name from a runtime std::string: copied
+    Name(const std::string& aName) : Name() { // NOLINT(runtime/explicit)
+        copy(aName.data(), aName.size());
+    }
+
+    Name(const Name& aOther) : mpData(aOther.mpData), mSize(aOther.mSize), mbShared(aOther.mbShared) {
+        if (mbShared) {
+            storage()->mRefs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    Name(Name&& aOther) noexcept : mpData(aOther.mpData), mSize(aOther.mSize), mbShared(aOther.mbShared) {
+        aOther.mpData = "";
+        aOther.mSize = 0;
+        aOther.mbShared = false;
+    }
+    Name& operator=(const Name& aOther) {
+        Name other(aOther);
+        swap(other);
+        return *this;
+    }
+    Name& operator=(Name&& aOther) noexcept {
+        Name other(std::move(aOther));
+        swap(other);
+        return *this;
+    }
+    ~Name() {
+        if (mbShared && (1 == storage()->mRefs.fetch_sub(1, std::memory_order_acq_rel))) {
+            storage()->~Storage();
+            ::operator delete(storage());
+        }
+    }
+
+    /// Name from a string literal with static storage duration: no copy (see operator""_name)
+    static Name literal(const char* apLiteral, const size_t aSize) {
+        return Name(apLiteral, static_cast<uint32_t>(aSize));
+    }
+
+    const char* data() const {
+        return mpData;
+    }
+    const char* c_str() const {
+        return mpData;
+    }
+    size_t size() const {
+        return mSize;
+    }
+    bool empty() const {
+        return 0 == mSize;
+    }
+
+    bool operator==(const Name& aOther) const {
+        return (mSize == aOther.mSize) && ((mpData == aOther.mpData) || (0 == memcmp(mpData, aOther.mpData, mSize)));
+    }
+    bool operator!=(const Name& aOther) const {
+        return !(*this == aOther);
+    }
+
+private:
+    Name(const char* apLiteral, const uint32_t aSize) : mpData(apLiteral), mSize(aSize), mbShared(false) {}
+
+    /// Header of the block of a runtime name, followed by its characters and a NUL terminator
+    struct Storage {
+        std::atomic<uint32_t> mRefs;
+    };
+
+    void copy(const char* apName, const size_t aSize) {
+        if (0 == aSize) {
+            return;
+        }
+        mSize = checkedSize(aSize);
+        void* pBlock = ::operator new(sizeof(Storage) + aSize + 1);
+        Storage* pStorage = new (pBlock) Storage();
+        pStorage->mRefs.store(1, std::memory_order_relaxed);
+        char* pData = static_cast<char*>(pBlock) + sizeof(Storage);
+        memcpy(pData, apName, aSize);
+        pData[aSize] = '\0';
+        mpData = pData;
+        mbShared = true;
+    }
+
+    Storage* storage() const {
+        return reinterpret_cast<Storage*>(const_cast<char*>(mpData) - sizeof(Storage));
+    }
+
+    void swap(Name& aOther) {
+        std::swap(mpData, aOther.mpData);
+        std::swap(mSize, aOther.mSize);
+        std::swap(mbShared, aOther.mbShared);
+    }
+
+    static uint32_t checkedSize(const size_t aSize) {
+        if (aSize > UINT32_MAX) {
+            throw std::length_error("HTML::Name too long");
+        }
+        return static_cast<uint32_t>(aSize);
+    }
+
+private:
+    const char* mpData;     ///< String literal or characters of the Storage, NUL-terminated, never null
+    uint32_t    mSize;      ///< Length of the name
+    bool        mbShared;   ///< The characters follow a reference counted Storage
+};
+
+inline namespace literals {
+
+/// Name of a string literal, used without any copy nor allocation, like "td"_name
+inline Name operator"" _name(const char* apLiteral, const size_t aSize) {
+    return Name::literal(apLiteral, aSize);
+}
+
+} // namespace literals
+
+} // namespace HTML
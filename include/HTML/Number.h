@@ -0,0 +1,335 @@
+/**
+ * @file    Number.h
+ * @ingroup HtmlBuilder
+ * @brief   Formatting of the numbers of attributes and text into a buffer on the stack, without any allocation.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include <clocale>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+
+#if (__cplusplus >= 201703L) || (defined(_MSVC_LANG) && (_MSVC_LANG >= 201703L))
+#include <charconv>
+#endif
+
+// Note: std::to_chars (C++17, with floating-point support since GCC 11 and MSVC 2019) is exact and locale-independent;
+// without it, the integers are formatted by hand and the floating-point numbers with snprintf().
+// Both ways give the exact same characters, so translation units compiled with different standards can be mixed.
+#if defined(__cpp_lib_to_chars)
+#define HTML_TO_CHARS 1
+#else
+#define HTML_TO_CHARS 0
+#endif
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/// Arithmetic types formatted as numbers: integers, floating-point numbers and bool, but not characters
+template<typename T>
+struct IsNumber : std::integral_constant<bool, std::is_arithmetic<T>::value &&
+                                               !std::is_same<T, char>::value && !std::is_same<T, wchar_t>::value &&
+                                               !std::is_same<T, char16_t>::value &&
+                                               !std::is_same<T, char32_t>::value> {};
+
+/**
+ * @brief Notation and precision of the floating-point numbers, like std::chars_format.
+ *
+ *   By default, a number is written with the fewest significant digits that read back to the exact same value,
+ * in fixed notation unless its exponent is below -4 or reaches the maximal number of digits of the type
+ * (17 for a double, 9 for a float), like "0.1", "3", "100000000", "0.0001", "1e-05" or "5e-324".
+ */
+struct FloatFormat {
+    enum class Notation {
+        Shortest,   ///< Fewest significant digits restoring the exact value
+        Fixed,      ///< Fixed number of decimals, like "%.*f"
+        Scientific, ///< Fixed number of decimals of the mantissa, like "%.*e"
+        General     ///< Fixed number of significant digits, like "%.*g"
+    };
+
+    /// Precision above which the digits are meaningless, keeping the formatted numbers in a small buffer
+    static const int MaxPrecision = 32;
+
+    constexpr explicit FloatFormat(const Notation aNotation = Notation::Shortest, const int aPrecision = 0) :
+        mNotation(aNotation),
+        mPrecision((aPrecision < 0) ? 0 : ((aPrecision < MaxPrecision) ? aPrecision : +MaxPrecision)) {}
+
+    static constexpr FloatFormat fixed(const int aPrecision) {
+        return FloatFormat(Notation::Fixed, aPrecision);
+    }
+    static constexpr FloatFormat scientific(const int aPrecision) {
+        return FloatFormat(Notation::Scientific, aPrecision);
+    }
+    static constexpr FloatFormat general(const int aPrecision) {
+        return FloatFormat(Notation::General, aPrecision);
+    }
+
+    Notation    mNotation;
+    int         mPrecision;     ///< Number of decimals, or of significant digits for the General notation
+};
+
+/**
+ * @brief Text of a number, formatted into a buffer on the stack.
+ *
+ *   Used by the numeric overloads of Element::addAttribute() and of the Text and Col constructors,
+ * and by the numeric columns of a DataTable to write their values straight into the output.
+ *
+ * @code
+    const HTML::Number number(3.14159, HTML::FloatFormat::fixed(2)); // "3.14"
+    aOutput.append(number.data(), number.size());
+ * @endcode
+ */
+class Number {
+public:
+    /// Size of the buffer, enough for the largest double in fixed notation with the maximal precision
+    static const size_t Capacity = 352;
+
+    template<typename T, typename std::enable_if<std::is_integral<T>::value &&
+                                                 !std::is_same<T, bool>::value, int>::type = 0>
+    explicit Number(const T aValue) {
+        formatInteger(static_cast<typename std::conditional<std::is_signed<T>::value,
+                                                            long long, unsigned long long>::type>(aValue));
+    }
+    template<typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    explicit Number(const T aValue, const FloatFormat aFormat = FloatFormat()) {
+        // Note: a float is written with the fewest digits restoring the float, not the double
+        formatFloat(static_cast<typename std::conditional<std::is_same<T, float>::value, float, double>::type>(aValue),
+                    aFormat);
+    }
+    /// "true" or "false", like std::boolalpha
+    explicit Number(const bool abValue) {
+        mSize = abValue ? 4 : 5;
+        memcpy(mBuffer, abValue ? "true" : "false", mSize);
+    }
+
+    const char* data() const {
+        return mBuffer;
+    }
+    size_t size() const {
+        return mSize;
+    }
+    std::string str() const {
+        return std::string(mBuffer, mSize);
+    }
+
+private:
+    void formatInteger(const long long aValue) {
+#if HTML_TO_CHARS
+        mSize = static_cast<size_t>(std::to_chars(mBuffer, mBuffer + Capacity, aValue).ptr - mBuffer);
+#else
+        // Note: negate in unsigned arithmetic, since the minimal value has no positive counterpart
+        if (aValue < 0) {
+            mBuffer[0] = '-';
+            mSize = 1 + formatDigits(mBuffer + 1, 0ULL - static_cast<unsigned long long>(aValue));
+        } else {
+            mSize = formatDigits(mBuffer, static_cast<unsigned long long>(aValue));
+        }
+#endif
+    }
+    void formatInteger(const unsigned long long aValue) {
+#if HTML_TO_CHARS
+        mSize = static_cast<size_t>(std::to_chars(mBuffer, mBuffer + Capacity, aValue).ptr - mBuffer);
+#else
+        mSize = formatDigits(mBuffer, aValue);
+#endif
+    }
+
+#if !HTML_TO_CHARS
+    /// Write the digits two at a time from the end of a temporary buffer, then move them in place
+    static size_t formatDigits(char* apBuffer, unsigned long long aValue) {
+        static const char pairs[] =
+            "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+            "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+            "8081828384858687888990919293949596979899";
+        char digits[20];
+        char* pBegin = digits + sizeof(digits);
+        while (aValue >= 100) {
+            const size_t pair = static_cast<size_t>(aValue % 100) * 2;
+            aValue /= 100;
+            *--pBegin = pairs[pair + 1];
+            *--pBegin = pairs[pair];
+        }
+        if (aValue >= 10) {
+            *--pBegin = pairs[aValue * 2 + 1];
+            *--pBegin = pairs[aValue * 2];
+        } else {
+            *--pBegin = static_cast<char>('0' + aValue);
+        }
+        const size_t size = static_cast<size_t>(digits + sizeof(digits) - pBegin);
+        memcpy(apBuffer, pBegin, size);
+        return size;
+    }
+#endif
+
+    template<typename T>
+    void formatFloat(const T aValue, const FloatFormat aFormat) {
+#if HTML_TO_CHARS
+        std::to_chars_result result;
+        switch (aFormat.mNotation) {
+        case FloatFormat::Notation::Fixed:
+            result = std::to_chars(mBuffer, mBuffer + Capacity, aValue, std::chars_format::fixed, aFormat.mPrecision);
+            break;
+        case FloatFormat::Notation::Scientific:
+            result = std::to_chars(mBuffer, mBuffer + Capacity, aValue, std::chars_format::scientific,
+                                   aFormat.mPrecision);
+            break;
+        case FloatFormat::Notation::General:
+            result = std::to_chars(mBuffer, mBuffer + Capacity, aValue, std::chars_format::general,
+                                   aFormat.mPrecision);
+            break;
+        case FloatFormat::Notation::Shortest:
+        default: {
+            // Note: the shortest scientific notation gives the first number of digits to try, as no fewer digits
+            // restore the value, but its rounding like "%.*e" may still need one more digit
+            result = std::to_chars(mBuffer, mBuffer + Capacity, aValue, std::chars_format::scientific);
+            int digits = 0;
+            for (const char* pChar = mBuffer; (pChar < result.ptr) && ('e' != *pChar); ++pChar) {
+                digits += ((*pChar >= '0') && (*pChar <= '9')) ? 1 : 0;
+            }
+            digits = (digits > 0) ? digits : 1;
+            result = std::to_chars(mBuffer, mBuffer + Capacity, aValue, std::chars_format::scientific, digits - 1);
+            while ((digits < std::numeric_limits<T>::max_digits10) && !isRestored(aValue, result.ptr)) {
+                ++digits;
+                result = std::to_chars(mBuffer, mBuffer + Capacity, aValue, std::chars_format::scientific, digits - 1);
+            }
+            mSize = static_cast<size_t>(result.ptr - mBuffer);
+            const int exponent = this->exponent();
+            if (isFixed<T>(exponent)) {
+                result = std::to_chars(mBuffer, mBuffer + Capacity, aValue, std::chars_format::fixed,
+                                       (digits - 1 - exponent > 0) ? digits - 1 - exponent : 0);
+            }
+            break;
+        }
+        }
+        mSize = static_cast<size_t>(result.ptr - mBuffer);
+#else
+        switch (aFormat.mNotation) {
+        case FloatFormat::Notation::Fixed:
+            print("%.*f", aFormat.mPrecision, aValue);
+            break;
+        case FloatFormat::Notation::Scientific:
+            print("%.*e", aFormat.mPrecision, aValue);
+            break;
+        case FloatFormat::Notation::General:
+            print("%.*g", aFormat.mPrecision, aValue);
+            break;
+        case FloatFormat::Notation::Shortest:
+        default: {
+            // Note: the first number of significant digits restoring the value, rounded like std::to_chars.
+            // Any decimal of at most digits10 digits is restored, so the value rounded to digits10 digits has
+            // the fewest digits once its trailing zeros are removed, unless it needs more than digits10 digits.
+            // The less precise subnormal numbers try all the numbers of digits.
+            const bool bSubnormal = (FP_SUBNORMAL == std::fpclassify(aValue));
+            int digits = bSubnormal ? 1 : std::numeric_limits<T>::digits10;
+            print("%.*e", digits - 1, aValue);
+            while ((digits < std::numeric_limits<T>::max_digits10) && !isRestored(aValue)) {
+                ++digits;
+                print("%.*e", digits - 1, aValue);
+            }
+            if (!bSubnormal && (std::numeric_limits<T>::digits10 == digits)) {
+                digits = trimZeros();
+            }
+            const int exponent = this->exponent();
+            if (isFixed<T>(exponent)) {
+                print("%.*f", (digits - 1 - exponent > 0) ? digits - 1 - exponent : 0, aValue);
+            }
+            break;
+        }
+        }
+        // Note: snprintf() uses the decimal point of the current C locale, like the ',' of many European languages
+        const char* pPoint = localeconv()->decimal_point;
+        const size_t pointSize = strlen(pPoint);
+        char* pFound = ((1 == pointSize) && ('.' == pPoint[0])) ? nullptr : strstr(mBuffer, pPoint);
+        if ((pointSize > 0) && pFound) {
+            *pFound = '.';
+            memmove(pFound + 1, pFound + pointSize, mSize - static_cast<size_t>(pFound + pointSize - mBuffer) + 1);
+            mSize -= pointSize - 1;
+        }
+#endif
+    }
+
+    /// Exponent of the number formatted in scientific notation, or INT_MAX without any (infinity or NaN)
+    int exponent() const {
+        const char* pChar = static_cast<const char*>(memchr(mBuffer, 'e', mSize));
+        if (!pChar) {
+            return std::numeric_limits<int>::max();
+        }
+        // Note: the buffer of std::to_chars is not null-terminated
+        const bool bNegative = ('-' == *++pChar);
+        int exponent = 0;
+        for (++pChar; pChar < mBuffer + mSize; ++pChar) {
+            exponent = exponent * 10 + (*pChar - '0');
+        }
+        return bNegative ? -exponent : exponent;
+    }
+    /// The Shortest notation is fixed unless the exponent is below -4, or reaches the maximal number of digits
+    template<typename T>
+    static bool isFixed(const int aExponent) {
+        return (aExponent >= -4) && (aExponent < std::numeric_limits<T>::max_digits10);
+    }
+
+#if HTML_TO_CHARS
+    /// Does the formatted number read back to the exact same bits
+    template<typename T>
+    bool isRestored(const T aValue, const char* apEnd) const {
+        T restored = 0;
+        std::from_chars(mBuffer, apEnd, restored);
+        return 0 == memcmp(&restored, &aValue, sizeof(T));
+    }
+#else
+    /// Does the formatted number read back to the exact same bits, a float being read as a float like std::from_chars
+    bool isRestored(const float aValue) const {
+        const float restored = strtof(mBuffer, nullptr);
+        return 0 == memcmp(&restored, &aValue, sizeof(float));
+    }
+    bool isRestored(const double aValue) const {
+        const double restored = strtod(mBuffer, nullptr);
+        return 0 == memcmp(&restored, &aValue, sizeof(double));
+    }
+    /// Remove the trailing zeros of the digits of the scientific notation, returning the number of digits left
+    int trimZeros() {
+        char* pExponent = static_cast<char*>(memchr(mBuffer, 'e', mSize));
+        if (!pExponent) {
+            return 1; // infinity
+        }
+        const char* pFirst = mBuffer + (('-' == mBuffer[0]) ? 1 : 0);
+        char* pEnd = pExponent;
+        while ((pEnd - 1 > pFirst) && ('0' == pEnd[-1])) {
+            --pEnd;
+        }
+        while ((pEnd[-1] < '0') || (pEnd[-1] > '9')) {
+            --pEnd; // decimal point without any digit after it
+        }
+        int digits = 0;
+        for (const char* pChar = pFirst; pChar < pEnd; ++pChar) {
+            digits += ((*pChar >= '0') && (*pChar <= '9')) ? 1 : 0;
+        }
+        const size_t exponentSize = static_cast<size_t>(mBuffer + mSize - pExponent);
+        memmove(pEnd, pExponent, exponentSize + 1);
+        mSize = static_cast<size_t>(pEnd - mBuffer) + exponentSize;
+        return digits;
+    }
+    void print(const char* apFormat, const int aPrecision, const double aValue) {
+        const int size = snprintf(mBuffer, Capacity, apFormat, aPrecision, aValue);
+        mSize = (size < 0) ? 0 : ((static_cast<size_t>(size) < Capacity) ? static_cast<size_t>(size) : Capacity - 1);
+        mBuffer[mSize] = '\0';
+    }
+#endif
+
+private:
+    char    mBuffer[Capacity];  ///< Formatted number, followed by a null terminator without std::to_chars
+    size_t  mSize;              ///< Number of characters of the number
+};
+
+} // namespace HTML
@@ -0,0 +1,183 @@
+/**
+ * @file    Parallel.h
+ * @ingroup HtmlBuilder
+ * @brief   Thread pool and policy used to serialize large lists of children on multiple cores.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Layout.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Fixed set of worker threads running the tasks of parallel serializations.
+ *
+ *   The calling thread of run() takes part in the work, so a pool with no worker runs everything serially.
+ */
+class ThreadPool {
+public:
+    /// Start the worker threads
+    explicit ThreadPool(const size_t aNbWorkers) {
+        mWorkers.reserve(aNbWorkers);
+        for (size_t idx = 0; idx < aNbWorkers; ++idx) {
+            mWorkers.emplace_back(&ThreadPool::work, this);
+        }
+    }
+    /// Wait for the queued tasks, then stop the worker threads
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mbStopping = true;
+        }
+        mCondition.notify_all();
+        for (auto& worker : mWorkers) {
+            worker.join();
+        }
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Pool shared by default by all parallel serializations, with a worker per additional core
+    static ThreadPool& shared() {
+        static ThreadPool pool(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 0);
+        return pool;
+    }
+
+    /// Number of threads available to run(), the calling thread included
+    size_t concurrency() const {
+        return mWorkers.size() + 1;
+    }
+
+    /**
+     * @brief Run aTask(0) to aTask(aCount - 1) on the workers and the calling thread, and wait for all of them.
+     *
+     * @throw the first exception thrown by a task, once all of them are finished
+     */
+    void run(const size_t aCount, const std::function<void(size_t)>& aTask) {
+        Batch batch(aTask, aCount);
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            for (size_t idx = 0; idx < aCount; ++idx) {
+                mTasks.push_back({&batch, idx});
+            }
+        }
+        mCondition.notify_all();
+        // Help the workers until all the tasks of the batch are started, then wait for the ones still running
+        Task task;
+        while (pop(batch, task)) {
+            execute(task);
+        }
+        std::unique_lock<std::mutex> lock(mMutex);
+        batch.mDone.wait(lock, [&batch] { return 0 == batch.mNbPending; });
+        if (batch.mpException) {
+            std::rethrow_exception(batch.mpException);
+        }
+    }
+
+private:
+    /// Tasks of a call to run(), living on the stack of the calling thread
+    struct Batch {
+        Batch(const std::function<void(size_t)>& aTask, const size_t aNbPending) :
+            mTask(aTask), mNbQueued(aNbPending), mNbPending(aNbPending) {}
+
+        const std::function<void(size_t)>&  mTask;
+        size_t                              mNbQueued;      ///< Tasks not started, protected by mMutex
+        size_t                              mNbPending;     ///< Tasks not finished, protected by mMutex
+        std::exception_ptr                  mpException;    ///< First exception thrown, protected by mMutex
+        std::condition_variable             mDone;          ///< Notified when mNbPending reaches 0
+    };
+    struct Task {
+        Batch*  mpBatch;
+        size_t  mIndex;
+    };
+
+    void work() {
+        for (;;) {
+            Task task;
+            {
+                std::unique_lock<std::mutex> lock(mMutex);
+                mCondition.wait(lock, [this] { return mbStopping || !mTasks.empty(); });
+                if (mTasks.empty()) {
+                    return;
+                }
+                task = mTasks.front();
+                mTasks.pop_front();
+                --task.mpBatch->mNbQueued;
+            }
+            execute(task);
+        }
+    }
+
+    /// Pop the next task, as long as some tasks of the batch are not started (they are after the front ones)
+    bool pop(const Batch& aBatch, Task& aTask) {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (0 == aBatch.mNbQueued) {
+            return false;
+        }
+        aTask = mTasks.front();
+        mTasks.pop_front();
+        --aTask.mpBatch->mNbQueued;
+        return true;
+    }
+
+    void execute(const Task& aTask) {
+        std::exception_ptr pException;
+        try {
+            aTask.mpBatch->mTask(aTask.mIndex);
+        } catch (...) {
+            pException = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (pException && !aTask.mpBatch->mpException) {
+            aTask.mpBatch->mpException = pException;
+        }
+        if (0 == --aTask.mpBatch->mNbPending) {
+            aTask.mpBatch->mDone.notify_all();
+        }
+    }
+
+private:
+    std::vector<std::thread>    mWorkers;
+    std::deque<Task>            mTasks;             ///< Queued tasks, protected by mMutex
+    std::mutex                  mMutex;
+    std::condition_variable     mCondition;         ///< Notified when tasks are queued or when stopping
+    bool                        mbStopping = false; ///< Protected by mMutex
+};
+
+/**
+ * @brief Opt-in parallel serialization, see Element::toString(const ParallelPolicy&).
+ *
+ *   The children of any Element having at least aMinChildren of them are split in consecutive chunks,
+ * each serialized into its own buffer by the ThreadPool; the buffers are then concatenated in order,
+ * so the output is identical to the serial one.
+ *
+ * @warning The Document must not be modified during the serialization.
+ */
+struct ParallelPolicy {
+    static const size_t DefaultMinChildren = 1024;
+
+    explicit ParallelPolicy(const size_t aMinChildren = DefaultMinChildren, ThreadPool& aPool = ThreadPool::shared(),
+                            const Format aFormat = Format::Pretty) :
+        mMinChildren(aMinChildren > 1 ? aMinChildren : 2), mPool(aPool), mFormat(aFormat) {}
+
+    size_t      mMinChildren;   ///< Number of children above which they are serialized in parallel
+    ThreadPool& mPool;          ///< Threads serializing the chunks of children
+    Format      mFormat;        ///< Layout of the generated HTML
+};
+
+} // namespace HTML
@@ -0,0 +1,217 @@
+/**
+ * @file    Render.h
+ * @ingroup HtmlBuilder
+ * @brief   Serialization of the Elements: the templates instantiated once by the compiled HtmlBuilder library.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Element.h"
+
+#include <algorithm>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Note: included at the end of Element.h in the default header-only mode; with HTML_COMPILED_LIBRARY,
+// only the library and the translation units serializing to a custom Output (or Layout) include it
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+template<typename Layout, typename Output>
+void Element::render(Output& aBuffer, const size_t aIndentation) const {
+    if (Layout::IsObserved) {
+        // Note: the measure of renderedSize() before a serialization is not reported
+        RenderObserver* pObserver = currentObserverPtr();
+        if (pObserver && !std::is_same<Output, SizeCounter>::value) {
+            renderObserved<Layout>(*pObserver, aBuffer, aIndentation);
+            return;
+        }
+    }
+    if (mbShared) {
+        // Note: the shared subtree is serialized directly to the Output, instead of through a Writer
+        static_cast<const Shared::Content&>(*mpRenderable).mElement.render<Layout>(aBuffer, aIndentation);
+        return;
+    }
+    if (mpRenderable) {
+        OutputWriter<Layout, Output> writer(aBuffer, aIndentation);
+        mpRenderable->render(writer, aIndentation);
+        return;
+    }
+    toStringOpen<Layout>(aBuffer, aIndentation);
+    toStringContent<Layout>(aBuffer, aIndentation);
+    toStringClose<Layout>(aBuffer, aIndentation);
+}
+
+template<typename Layout>
+void Element::render(std::string& aBuffer, const size_t aIndentation, const ParallelPolicy& aPolicy) const {
+    if (mpRenderable || mName.empty()) {
+        render<Layout>(aBuffer, aIndentation);
+        return;
+    }
+    toStringOpen<Layout>(aBuffer, aIndentation);
+    toStringText(aBuffer);
+    if (mChildren.size() >= aPolicy.mMinChildren) {
+        renderChildren<Layout>(aBuffer, aIndentation + Layout::Indentation, aPolicy);
+    } else {
+        for (auto& child : mChildren) {
+            child.render<Layout>(aBuffer, aIndentation + Layout::Indentation, aPolicy);
+        }
+    }
+    toStringClose<Layout>(aBuffer, aIndentation);
+}
+
+template<typename Layout>
+void Element::renderChildren(std::string& aBuffer, const size_t aIndentation, const ParallelPolicy& aPolicy) const {
+    // A few chunks per thread balance the load between the lists of short and of long children
+    const size_t nbChunks = std::min(mChildren.size(), aPolicy.mPool.concurrency() * 4);
+    std::vector<std::string> chunks(nbChunks);
+    aPolicy.mPool.run(nbChunks, [&](const size_t aChunk) {
+        const size_t begin = mChildren.size() * aChunk / nbChunks;
+        const size_t end = mChildren.size() * (aChunk + 1) / nbChunks;
+        SizeCounter counter;
+        for (size_t idx = begin; idx < end; ++idx) {
+            mChildren[idx].render<Layout>(counter, aIndentation);
+        }
+        chunks[aChunk].reserve(counter.size());
+        for (size_t idx = begin; idx < end; ++idx) {
+            mChildren[idx].render<Layout>(chunks[aChunk], aIndentation);
+        }
+    });
+    size_t size = aBuffer.size();
+    for (const auto& chunk : chunks) {
+        size += chunk.size();
+    }
+    aBuffer.reserve(size);
+    for (const auto& chunk : chunks) {
+        aBuffer += chunk;
+    }
+}
+
+template<typename Layout, typename Output>
+void Element::renderObserved(RenderObserver& aObserver, Output& aBuffer, const size_t aIndentation) const {
+    if (mpRenderable) {
+        aObserver.onBegin(RenderPhase::Content, mName);
+        OutputWriter<Layout, Output> writer(aBuffer, aIndentation);
+        mpRenderable->render(writer, aIndentation);
+        aObserver.onEnd(RenderPhase::Content, mName);
+        return;
+    }
+    aObserver.onBegin(RenderPhase::Open, mName);
+    toStringOpen<Layout>(aBuffer, aIndentation);
+    aObserver.onEnd(RenderPhase::Open, mName);
+    aObserver.onBegin(RenderPhase::Content, mName);
+    toStringContent<Layout>(aBuffer, aIndentation);
+    aObserver.onEnd(RenderPhase::Content, mName);
+    aObserver.onBegin(RenderPhase::Close, mName);
+    toStringClose<Layout>(aBuffer, aIndentation);
+    aObserver.onEnd(RenderPhase::Close, mName);
+}
+
+template<typename Layout>
+void Element::collectStats(RenderStats& aStats, const size_t aIndentation, const size_t aDepth) const {
+    SizeCounter counter;
+    ++aStats.mNodes;
+    aStats.mMaxDepth = std::max(aStats.mMaxDepth, aDepth);
+    if (mpRenderable || mName.empty()) {
+        render<Layout>(counter, aIndentation);
+        aStats.mBytesPerTag[mpRenderable ? "#custom" : "#text"] += counter.size();
+    } else {
+        aStats.mAttributes += mAttributes.size();
+        toStringOpen<Layout>(counter, aIndentation);
+        toStringText(counter);
+        toStringClose<Layout>(counter, aIndentation);
+        aStats.mBytesPerTag[std::string(mName.data(), mName.size())] += counter.size();
+        for (const auto& child : mChildren) {
+            child.collectStats<Layout>(aStats, aIndentation + Layout::Indentation, aDepth + 1);
+        }
+    }
+    aStats.mBytes += counter.size();
+}
+
+template<typename Layout, typename Output>
+void Element::toStringTag(Output& aBuffer, const size_t aIndentation) const {
+    Layout::indent(aBuffer, aIndentation);
+    aBuffer += '<';
+    aBuffer.append(mName.data(), mName.size());
+
+    for (const auto& attr : mAttributes) {
+        aBuffer += ' ';
+        aBuffer.append(attr.Name.data(), attr.Name.size());
+        if (!attr.Value.empty()) {
+            append(aBuffer, "=\"");
+            appendEscaped(aBuffer, attr.Value.data(), attr.Value.size());
+            aBuffer += '"';
+        }
+    }
+}
+
+template<typename Layout, typename Output>
+void Element::toStringOpen(Output& aBuffer, const size_t aIndentation) const {
+    if (!mName.empty()) {
+        toStringTag<Layout>(aBuffer, aIndentation);
+
+        if (mContent.empty()) {
+            // Note: using children for content is less efficient/breaking the assumption
+            if (!mChildren.empty() || mbVoid) {
+                Layout::tagEndline(aBuffer);
+            } else {
+                aBuffer += '>';
+            }
+        } else {
+            aBuffer += '>';
+        }
+    }
+}
+
+template<typename Output>
+void Element::toStringText(Output& aBuffer) const {
+    if (mbRaw) {
+        aBuffer += mContent;
+    } else {
+        appendEscaped(aBuffer, mContent.data(), mContent.size());
+    }
+}
+
+template<typename Layout, typename Output>
+void Element::toStringContent(Output& aBuffer, const size_t aIndentation) const {
+    if (!mName.empty()) {
+        toStringText(aBuffer);
+        for (auto& child : mChildren) {
+            child.render<Layout>(aBuffer, aIndentation + Layout::Indentation);
+        }
+    } else {
+        Layout::indent(aBuffer, aIndentation);
+        toStringText(aBuffer);
+        Layout::endline(aBuffer);
+    }
+}
+
+template<typename Layout, typename Output>
+void Element::toStringClose(Output& aBuffer, const size_t aIndentation) const {
+    if (!mName.empty()) {
+        if (!mChildren.empty()) {
+            Layout::indent(aBuffer, aIndentation);
+        }
+        // Note: using children for content is less efficient/breaking the assumption
+        if (!mContent.empty() || !mChildren.empty() || !mbVoid) {
+            append(aBuffer, "</");
+            aBuffer.append(mName.data(), mName.size());
+            Layout::tagEndline(aBuffer);
+        }
+    }
+}
+
+#if !HTML_COMPILED_LIBRARY
+inline std::ostream& operator<<(std::ostream& aStream, const Element& aElement) {
+    const std::string buffer = aElement.toString();
+    return aStream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+#endif
+
+} // namespace HTML
@@ -0,0 +1,280 @@
+/**
+ * @file    SharedVector.h
+ * @ingroup HtmlBuilder
+ * @brief   Copy-on-write vector, used to share the unchanged children between copies of an Element.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Subset of the std::vector interface, whose copies share the same elements until one of them is modified.
+ *
+ *   The elements are stored after a reference counted header, in a single block allocated by Alloc. A copy only
+ * increments the reference count, and the first modification of a shared vector copies its elements first,
+ * so copying a tree of vectors of vectors costs the number of vectors modified afterward, not the size of the tree.
+ * Like std::vector it accepts an incomplete type, and it is only the size of a pointer and of an Alloc.
+ *
+ *   Two vectors share their elements only if they use the same allocator, so a copy using another MemoryResource
+ * (see ScopedResource) never refers to the memory of the original one.
+ *
+ * @warning A reference to an element is only valid until the vector is copied: modify it through the vector again.
+ *          The copies sharing their elements can be used by different threads, but each copy by only one at a time.
+ */
+template<typename T, typename Alloc = std::allocator<T>>
+class SharedVector {
+    /// Reference counted header of the block of elements
+    struct Header {
+        std::atomic<size_t> mRefs;
+        uint32_t            mSize;
+        uint32_t            mCapacity;
+        Alloc               mAllocator;     ///< Allocator of the block
+    };
+    /// Unit of allocation, aligned for the header as well as for the elements
+    typedef typename std::aligned_storage<sizeof(Header), alignof(std::max_align_t)>::type Unit;
+    typedef typename std::allocator_traits<Alloc>::template rebind_alloc<Unit> UnitAlloc;
+
+public:
+    typedef T           value_type;
+    typedef const T*    const_iterator;
+    typedef size_t      size_type;
+
+    SharedVector() {}
+    SharedVector(std::initializer_list<T> aList) {
+        reserve(aList.size());
+        for (const T& value : aList) {
+            emplace_back(value);
+        }
+    }
+    SharedVector(const SharedVector& aOther) :
+        mAllocator(std::allocator_traits<Alloc>::select_on_container_copy_construction(aOther.mAllocator)) {
+        share(aOther);
+    }
+    SharedVector(SharedVector&& aOther) noexcept : mpHeader(aOther.mpHeader), mAllocator(std::move(aOther.mAllocator)) {
+        aOther.mpHeader = nullptr;
+    }
+    ~SharedVector() {
+        release();
+    }
+
+    SharedVector& operator=(const SharedVector& aOther) {
+        if (mpHeader != aOther.mpHeader) {
+            // Share before releasing, since aOther may belong to one of the elements to destroy
+            SharedVector other(aOther, mAllocator);
+            std::swap(mpHeader, other.mpHeader);
+        }
+        return *this;
+    }
+    SharedVector& operator=(SharedVector&& aOther) noexcept {
+        if (this != &aOther) {
+            Header* pHeader = aOther.mpHeader;
+            aOther.mpHeader = nullptr;
+            release();
+            mpHeader = pHeader;
+            mAllocator = std::move(aOther.mAllocator);
+        }
+        return *this;
+    }
+
+    const_iterator begin() const {
+        return data();
+    }
+    const_iterator end() const {
+        return data() + size();
+    }
+
+    size_t size() const {
+        return mpHeader ? mpHeader->mSize : 0;
+    }
+    size_t capacity() const {
+        return mpHeader ? mpHeader->mCapacity : 0;
+    }
+    bool empty() const {
+        return 0 == size();
+    }
+
+    const T& operator[](const size_t aIndex) const {
+        return data()[aIndex];
+    }
+    const T& back() const {
+        return data()[size() - 1];
+    }
+    /// Modify an element, after copying the elements if they are shared
+    T& operator[](const size_t aIndex) {
+        unshare(capacity());
+        return data()[aIndex];
+    }
+    T& back() {
+        unshare(capacity());
+        return data()[size() - 1];
+    }
+
+    /// Allocate room for aCapacity elements at once, if they do not fit in the current block
+    void reserve(const size_t aCapacity) {
+        if (aCapacity > capacity()) {
+            Header* pHeader = allocate(aCapacity);
+            transfer(pHeader);
+        }
+    }
+
+    void push_back(T&& aValue) {
+        emplace_back(std::move(aValue));
+    }
+    void push_back(const T& aValue) {
+        emplace_back(aValue);
+    }
+    template<typename... Args>
+    void emplace_back(Args&&... aArgs) {
+        const size_t size = this->size();
+        if ((size < capacity()) && isUnique()) {
+            ::new(static_cast<void*>(data() + size)) T(std::forward<Args>(aArgs)...);
+        } else if (mpHeader && !isUnique()) {
+            // Copy the shared elements first: the arguments may refer to one of them, kept alive by the other copies
+            transfer(allocate((size < capacity()) ? capacity() : 2 * size));
+            ::new(static_cast<void*>(data() + size)) T(std::forward<Args>(aArgs)...);
+        } else {
+            // Construct the new element before moving the others, since the arguments may refer to one of them
+            Header* pHeader = allocate((size > 0) ? 2 * size : 1);
+            try {
+                ::new(static_cast<void*>(elements(pHeader) + size)) T(std::forward<Args>(aArgs)...);
+            } catch (...) {
+                deallocate(pHeader);
+                throw;
+            }
+            transfer(pHeader);
+        }
+        ++mpHeader->mSize;
+    }
+
+    /// Destroy all the elements, keeping the block for the next ones unless it is shared with copies
+    void clear() {
+        if (isUnique()) {
+            for (size_t idx = 0; idx < mpHeader->mSize; ++idx) {
+                elements(mpHeader)[idx].~T();
+            }
+            mpHeader->mSize = 0;
+        } else {
+            release();
+        }
+    }
+
+private:
+    /// Copy sharing the elements of aOther if it uses the given allocator, for the copy assignment
+    SharedVector(const SharedVector& aOther, const Alloc& aAllocator) : mAllocator(aAllocator) {
+        share(aOther);
+    }
+
+    static size_t headerUnits() {
+        return (sizeof(Header) + sizeof(Unit) - 1) / sizeof(Unit);
+    }
+    static T* elements(Header* apHeader) {
+        return reinterpret_cast<T*>(reinterpret_cast<Unit*>(apHeader) + headerUnits());
+    }
+    const T* data() const {
+        return mpHeader ? elements(mpHeader) : nullptr;
+    }
+    T* data() {
+        return mpHeader ? elements(mpHeader) : nullptr;
+    }
+    bool isUnique() const {
+        return mpHeader && (1 == mpHeader->mRefs.load(std::memory_order_acquire));
+    }
+
+    /// Share the block of aOther if it uses the same allocator, else copy its elements
+    void share(const SharedVector& aOther) {
+        if (aOther.mpHeader && (aOther.mpHeader->mAllocator == mAllocator)) {
+            aOther.mpHeader->mRefs.fetch_add(1, std::memory_order_relaxed);
+            mpHeader = aOther.mpHeader;
+        } else if (aOther.mpHeader) {
+            reserve(aOther.size());
+            for (const T& value : aOther) {
+                emplace_back(value);
+            }
+        }
+    }
+
+    /// Copy the elements if they are shared, before a modification
+    void unshare(const size_t aCapacity) {
+        if (mpHeader && !isUnique()) {
+            transfer(allocate(aCapacity));
+        }
+    }
+
+    Header* allocate(const size_t aCapacity) {
+        static_assert(std::is_nothrow_move_constructible<T>::value, "elements must be nothrow move constructible");
+        static_assert(alignof(T) <= alignof(Unit), "elements must not be over-aligned");
+        if (aCapacity > UINT32_MAX) {
+            throw std::length_error("HTML::SharedVector capacity");
+        }
+        UnitAlloc allocator(mAllocator);
+        const size_t units = headerUnits() + (aCapacity * sizeof(T) + sizeof(Unit) - 1) / sizeof(Unit);
+        Header* pHeader = reinterpret_cast<Header*>(std::allocator_traits<UnitAlloc>::allocate(allocator, units));
+        ::new(static_cast<void*>(pHeader)) Header{{1}, 0, static_cast<uint32_t>(aCapacity), mAllocator};
+        return pHeader;
+    }
+    static void deallocate(Header* apHeader) {
+        UnitAlloc allocator(apHeader->mAllocator);
+        const size_t units = headerUnits() + (apHeader->mCapacity * sizeof(T) + sizeof(Unit) - 1) / sizeof(Unit);
+        apHeader->~Header();
+        std::allocator_traits<UnitAlloc>::deallocate(allocator, reinterpret_cast<Unit*>(apHeader), units);
+    }
+
+    /// Move the elements to a new block (or copy them if they are shared), and release the current one
+    void transfer(Header* apHeader) {
+        const size_t size = this->size();
+        if (isUnique()) {
+            for (size_t idx = 0; idx < size; ++idx) {
+                ::new(static_cast<void*>(elements(apHeader) + idx)) T(std::move(data()[idx]));
+            }
+        } else {
+            size_t idx = 0;
+            try {
+                for (; idx < size; ++idx) {
+                    ::new(static_cast<void*>(elements(apHeader) + idx)) T(data()[idx]);
+                }
+            } catch (...) {
+                for (size_t copied = 0; copied < idx; ++copied) {
+                    elements(apHeader)[copied].~T();
+                }
+                deallocate(apHeader);
+                throw;
+            }
+        }
+        apHeader->mSize = static_cast<uint32_t>(size);
+        release();
+        mpHeader = apHeader;
+    }
+
+    /// Drop the reference to the block, destroying its elements if it was the last one
+    void release() {
+        if (mpHeader && (1 == mpHeader->mRefs.fetch_sub(1, std::memory_order_acq_rel))) {
+            for (size_t idx = 0; idx < mpHeader->mSize; ++idx) {
+                elements(mpHeader)[idx].~T();
+            }
+            deallocate(mpHeader);
+        }
+        mpHeader = nullptr;
+    }
+
+private:
+    Header* mpHeader = nullptr; ///< Block of elements, shared with the copies, allocated at the first insertion
+    Alloc   mAllocator;         ///< Allocator of the new blocks
+};
+
+} // namespace HTML
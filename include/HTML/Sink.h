@@ -0,0 +1,151 @@
+/**
+ * @file    Sink.h
+ * @ingroup HtmlBuilder
+ * @brief   Destinations receiving the generated HTML chunk by chunk.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+// Note: vectored writes to file descriptors and sockets (see DescriptorSink) are only available on POSIX systems
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/uio.h>
+#include <unistd.h>
+#include <cerrno>
+#include <climits>
+#include <system_error>
+#define HTML_SINK_POSIX
+#endif
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+#if defined(HTML_SINK_POSIX)
+/// Chunk of data of a vectored write, the struct iovec of writev() and sendmsg()
+typedef ::iovec IoSlice;
+#else
+/// Chunk of data of a vectored write, with the same members as the POSIX struct iovec
+struct IoSlice {
+    void*   iov_base;
+    size_t  iov_len;
+};
+#endif
+
+/**
+ * @brief Destination receiving the generated HTML chunk by chunk (stream, socket, compressor...).
+ */
+class Sink {
+public:
+    virtual ~Sink() {}
+
+    /// Consume a chunk of generated HTML; the data is only valid during the call.
+    virtual void write(const char* apData, size_t aSize) = 0;
+
+    /// Consume consecutive chunks of generated HTML at once (see VectoredOutput), like as many write() calls.
+    virtual void writev(const IoSlice* apSlices, size_t aCount) {
+        for (size_t idx = 0; idx < aCount; ++idx) {
+            write(static_cast<const char*>(apSlices[idx].iov_base), apSlices[idx].iov_len);
+        }
+    }
+};
+
+/// Sink writing to a std::ostream
+class StreamSink : public Sink {
+public:
+    explicit StreamSink(std::ostream& aStream) : mStream(aStream) {}
+
+    void write(const char* apData, size_t aSize) override {
+        mStream.write(apData, static_cast<std::streamsize>(aSize));
+    }
+
+private:
+    std::ostream& mStream;
+};
+
+/// Sink appending to a std::string
+class StringSink : public Sink {
+public:
+    explicit StringSink(std::string& aString) : mString(aString) {}
+
+    void write(const char* apData, size_t aSize) override {
+        mString.append(apData, aSize);
+    }
+    void writev(const IoSlice* apSlices, size_t aCount) override {
+        size_t size = mString.size();
+        for (size_t idx = 0; idx < aCount; ++idx) {
+            size += apSlices[idx].iov_len;
+        }
+        mString.reserve(size);
+        Sink::writev(apSlices, aCount);
+    }
+
+private:
+    std::string& mString;
+};
+
+#if defined(HTML_SINK_POSIX)
+/**
+ * @brief Sink writing to a blocking file descriptor or socket, with a single writev() system call per batch of chunks.
+ *
+ *   Partial writes are completed and interrupted calls restarted; any other error throws a std::system_error.
+ *
+ * @warning Writing to a socket closed by the peer raises SIGPIPE: ignore it, or set SO_NOSIGPIPE where available.
+ */
+class DescriptorSink : public Sink {
+public:
+    explicit DescriptorSink(const int aDescriptor) : mDescriptor(aDescriptor) {}
+
+    void write(const char* apData, size_t aSize) override {
+        while (aSize > 0) {
+            const ssize_t written = ::write(mDescriptor, apData, aSize);
+            if (written < 0) {
+                check();
+                continue;
+            }
+            apData += written;
+            aSize -= static_cast<size_t>(written);
+        }
+    }
+
+    void writev(const IoSlice* apSlices, size_t aCount) override {
+        while (aCount > 0) {
+            const int count = static_cast<int>((aCount < IOV_MAX) ? aCount : IOV_MAX);
+            const ssize_t written = ::writev(mDescriptor, apSlices, count);
+            if (written < 0) {
+                check();
+                continue;
+            }
+            size_t remaining = static_cast<size_t>(written);
+            for (; (aCount > 0) && (remaining >= apSlices->iov_len); ++apSlices, --aCount) {
+                remaining -= apSlices->iov_len;
+            }
+            if (remaining > 0) {
+                // Complete the chunk partially written, then go on with the next ones
+                write(static_cast<const char*>(apSlices->iov_base) + remaining, apSlices->iov_len - remaining);
+                ++apSlices;
+                --aCount;
+            }
+        }
+    }
+
+private:
+    /// Throw on a failed system call, unless it was only interrupted by a signal
+    static void check() {
+        if (EINTR != errno) {
+            throw std::system_error(errno, std::generic_category(), "HTML::DescriptorSink");
+        }
+    }
+
+private:
+    const int mDescriptor;  ///< File descriptor or socket, not owned
+};
+#endif
+
+} // namespace HTML
@@ -0,0 +1,254 @@
+/**
+ * @file    SmallVector.h
+ * @ingroup HtmlBuilder
+ * @brief   Vector storing its first elements inline, used for the attributes of an Element.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/// Uninitialized inline storage for the first N elements of a SmallVector
+template<typename T, size_t N>
+class InlineBuffer {
+protected:
+    T* inlineData() {
+        return reinterpret_cast<T*>(mBuffer);
+    }
+
+private:
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type mBuffer[N];
+};
+
+/// No inline storage: the SmallVector is a compact vector, usable with an incomplete type like std::vector
+template<typename T>
+class InlineBuffer<T, 0> {
+protected:
+    T* inlineData() {
+        return nullptr;
+    }
+};
+
+/**
+ * @brief Subset of the std::vector interface, storing up to N elements inline before allocating from the heap.
+ *
+ *   Most Elements have very few attributes, so storing them inline saves a heap allocation per Element.
+ * Even without inline storage (N = 0) the size and the capacity (32 bits each) make it smaller than a std::vector.
+ *
+ * @tparam T        Type of the elements, nothrow move constructible
+ * @tparam N        Number of elements stored inline
+ * @tparam Alloc    Allocator of the elements exceeding the inline storage
+ *
+ * @warning Unlike std::vector, moving a SmallVector relocates its inline elements.
+ */
+template<typename T, size_t N, typename Alloc = std::allocator<T>>
+class SmallVector : private InlineBuffer<T, N> {
+    typedef std::allocator_traits<Alloc> Traits;
+
+public:
+    typedef T           value_type;
+    typedef T*          iterator;
+    typedef const T*    const_iterator;
+    typedef size_t      size_type;
+
+    SmallVector() : mpData(this->inlineData()) {}
+    SmallVector(std::initializer_list<T> aList) : SmallVector() {
+        assign(aList.begin(), aList.end());
+    }
+    SmallVector(const SmallVector& aOther) :
+        mpData(this->inlineData()), mAllocator(Traits::select_on_container_copy_construction(aOther.mAllocator)) {
+        assign(aOther.begin(), aOther.end());
+    }
+    SmallVector(SmallVector&& aOther) noexcept : mpData(this->inlineData()), mAllocator(std::move(aOther.mAllocator)) {
+        steal(aOther);
+    }
+    ~SmallVector() {
+        clear();
+        deallocate();
+    }
+
+    SmallVector& operator=(const SmallVector& aOther) {
+        if (this != &aOther) {
+            clear();
+            assign(aOther.begin(), aOther.end());
+        }
+        return *this;
+    }
+    SmallVector& operator=(SmallVector&& aOther) noexcept {
+        if (this != &aOther) {
+            // Take the elements first, since aOther may belong to one of the elements to destroy
+            SmallVector other(std::move(aOther));
+            clear();
+            deallocate();
+            mAllocator = std::move(other.mAllocator);
+            steal(other);
+        }
+        return *this;
+    }
+
+    iterator begin() {
+        return mpData;
+    }
+    iterator end() {
+        return mpData + mSize;
+    }
+    const_iterator begin() const {
+        return mpData;
+    }
+    const_iterator end() const {
+        return mpData + mSize;
+    }
+
+    size_t size() const {
+        return mSize;
+    }
+    size_t capacity() const {
+        return mCapacity;
+    }
+    bool empty() const {
+        return 0 == mSize;
+    }
+
+    T& operator[](const size_t aIndex) {
+        return mpData[aIndex];
+    }
+    const T& operator[](const size_t aIndex) const {
+        return mpData[aIndex];
+    }
+    T& back() {
+        return mpData[mSize - 1];
+    }
+    const T& back() const {
+        return mpData[mSize - 1];
+    }
+
+    /// Allocate room for aCapacity elements at once, if they do not fit in the current storage
+    void reserve(const size_t aCapacity) {
+        if (aCapacity > mCapacity) {
+            T* pData = allocate(aCapacity);
+            relocate(pData);
+            deallocate();
+            mpData = pData;
+            mCapacity = static_cast<uint32_t>(aCapacity);
+        }
+    }
+
+    void push_back(T&& aValue) {
+        emplace_back(std::move(aValue));
+    }
+    void push_back(const T& aValue) {
+        emplace_back(aValue);
+    }
+    template<typename... Args>
+    void emplace_back(Args&&... aArgs) {
+        if (mSize < mCapacity) {
+            ::new(static_cast<void*>(mpData + mSize)) T(std::forward<Args>(aArgs)...);
+        } else {
+            // Construct the new element before relocating the others, since the arguments may refer to one of them
+            const size_t capacity = (mCapacity > 0) ? 2 * size_t(mCapacity) : 1;
+            T* pData = allocate(capacity);
+            try {
+                ::new(static_cast<void*>(pData + mSize)) T(std::forward<Args>(aArgs)...);
+            } catch (...) {
+                Traits::deallocate(mAllocator, pData, capacity);
+                throw;
+            }
+            relocate(pData);
+            deallocate();
+            mpData = pData;
+            mCapacity = static_cast<uint32_t>(capacity);
+        }
+        ++mSize;
+    }
+
+    /// Destroy all the elements, keeping the storage
+    void clear() {
+        for (size_t idx = 0; idx < mSize; ++idx) {
+            mpData[idx].~T();
+        }
+        mSize = 0;
+    }
+
+private:
+    bool isInline() const {
+        return mpData == const_cast<SmallVector*>(this)->inlineData();
+    }
+
+    T* allocate(const size_t aCapacity) {
+        if (aCapacity > UINT32_MAX) {
+            throw std::length_error("HTML::SmallVector capacity");
+        }
+        return Traits::allocate(mAllocator, aCapacity);
+    }
+    /// Release the heap storage, if any, once its elements are destroyed or relocated
+    void deallocate() {
+        if (!isInline()) {
+            Traits::deallocate(mAllocator, mpData, mCapacity);
+            mpData = this->inlineData();
+            mCapacity = N;
+        }
+    }
+
+    /// Move the elements to new storage, leaving the current one uninitialized
+    void relocate(T* apData) {
+        static_assert(std::is_nothrow_move_constructible<T>::value, "elements must be nothrow move constructible");
+        for (size_t idx = 0; idx < mSize; ++idx) {
+            ::new(static_cast<void*>(apData + idx)) T(std::move(mpData[idx]));
+            mpData[idx].~T();
+        }
+    }
+
+    /// Copy the elements of a forward range into an empty vector, destroying the ones already copied on an exception
+    template<typename Iterator>
+    void assign(Iterator aBegin, const Iterator aEnd) {
+        reserve(static_cast<size_t>(std::distance(aBegin, aEnd)));
+        try {
+            for (; aBegin != aEnd; ++aBegin) {
+                emplace_back(*aBegin);
+            }
+        } catch (...) {
+            clear();
+            deallocate();
+            throw;
+        }
+    }
+
+    /// Take the elements of an empty vector using the same allocator: the heap storage, or a move of the inline ones
+    void steal(SmallVector& aOther) {
+        if (aOther.isInline()) {
+            aOther.relocate(mpData);
+            mSize = aOther.mSize;
+            aOther.mSize = 0;
+        } else {
+            mpData = aOther.mpData;
+            mSize = aOther.mSize;
+            mCapacity = aOther.mCapacity;
+            aOther.mpData = aOther.inlineData();
+            aOther.mSize = 0;
+            aOther.mCapacity = N;
+        }
+    }
+
+private:
+    T*          mpData;                 ///< Inline storage, or heap storage allocated by mAllocator
+    uint32_t    mSize = 0;              ///< Number of elements
+    uint32_t    mCapacity = N;          ///< Number of elements fitting in the storage
+    Alloc       mAllocator;
+};
+
+} // namespace HTML
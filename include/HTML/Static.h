@@ -0,0 +1,509 @@
+/**
+ * @file    Static.h
+ * @ingroup HtmlBuilder
+ * @brief   Compile-time rendering of static markup, with typed placeholder slots filled at render time.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+// Note: generating arrays at compile time requires the relaxed constexpr functions of C++14
+#if (__cplusplus < 201402L) && (!defined(_MSVC_LANG) || (_MSVC_LANG < 201402L))
+#error "HTML/Static.h requires C++14"
+#endif
+
+#include "Element.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Compile-time description of static markup, rendered into a static constexpr char array.
+ *
+ *   The tree is described with tag() and voidTag(), taking attributes, text content (plain string literals)
+ * and child nodes in any order. Placeholder slots mark the values only known at render time.
+ * The result of HTML_STATIC() is a constant holding the exact HTML that the equivalent Element tree generates,
+ * to insert in a Document with a StaticMarkup (see below).
+ *
+ * @code
+    static constexpr auto kNavbar = HTML::Static::tag("nav", HTML::Static::cls("navbar"),
+        HTML::Static::tag("a", "Home", HTML::Static::attr("href", "/")),
+        HTML::Static::tag("span", HTML::Static::cls("user"), HTML::Static::textSlot(0)));
+    static constexpr auto kNavbarHtml = HTML_STATIC(kNavbar);
+
+    document << HTML::StaticMarkup(kNavbarHtml).set(0, userName);
+ * @endcode
+ */
+namespace Static {
+
+/// Length of a NUL-terminated string
+constexpr size_t length(const char* apString) {
+    size_t size = 0;
+    while (apString[size]) {
+        ++size;
+    }
+    return size;
+}
+
+/// Static attribute, written with its value escaped
+struct Attribute {
+    const char* mpName;
+    const char* mpValue;
+};
+
+/// Static unnamed text node, like the Text Element
+struct Text {
+    const char* mpContent;
+};
+
+/// Kind of position in the static HTML: layout of a line, or runtime value of a placeholder slot
+enum class EventKind {
+    Indent,     ///< Indentation of a line
+    EndLine,    ///< End of a line
+    Text,       ///< Text node, escaped
+    Attribute,  ///< Value of an attribute, escaped
+    Element     ///< Child Element, rendered at the depth of the slot
+};
+
+/// Placeholder for a runtime text node
+struct TextSlot {
+    size_t mIndex;
+};
+
+/// Placeholder for the runtime value of an attribute
+struct AttributeSlot {
+    const char* mpName;
+    size_t      mIndex;
+};
+
+/// Placeholder for a runtime child Element
+struct ElementSlot {
+    size_t mIndex;
+};
+
+/// Compile-time heterogeneous list of the arguments of a node
+template<typename... Args>
+struct List;
+template<>
+struct List<> {};
+template<typename Head, typename... Tail>
+struct List<Head, Tail...> {
+    Head            mHead;
+    List<Tail...>   mTail;
+};
+
+constexpr List<> makeList() {
+    return List<>{};
+}
+template<typename Head, typename... Tail>
+constexpr List<Head, Tail...> makeList(const Head& aHead, const Tail&... aTail) {
+    return List<Head, Tail...>{aHead, makeList(aTail...)};
+}
+
+/// Static named node, with its attributes, text content and children
+template<typename... Args>
+struct Node {
+    const char*     mpName;
+    bool            mbVoid;
+    List<Args...>   mArgs;
+};
+
+/// Static Element: the arguments are Attribute, string literals for the text content, child nodes and slots
+template<typename... Args>
+constexpr Node<Args...> tag(const char* apName, Args... aArgs) {
+    return Node<Args...>{apName, false, makeList(aArgs...)};
+}
+/// Static self-closing Element like \<br\>, \<img\> or \<input\>
+template<typename... Args>
+constexpr Node<Args...> voidTag(const char* apName, Args... aArgs) {
+    return Node<Args...>{apName, true, makeList(aArgs...)};
+}
+
+constexpr Attribute attr(const char* apName, const char* apValue) {
+    return Attribute{apName, apValue};
+}
+constexpr Attribute id(const char* apValue) {
+    return Attribute{"id", apValue};
+}
+constexpr Attribute cls(const char* apValue) {
+    return Attribute{"class", apValue};
+}
+constexpr Text text(const char* apContent) {
+    return Text{apContent};
+}
+constexpr TextSlot textSlot(const size_t aIndex) {
+    return TextSlot{aIndex};
+}
+constexpr AttributeSlot attributeSlot(const char* apName, const size_t aIndex) {
+    return AttributeSlot{apName, aIndex};
+}
+constexpr ElementSlot elementSlot(const size_t aIndex) {
+    return ElementSlot{aIndex};
+}
+
+/// Position in the static HTML where a line is indented or ended, or where a slot value is inserted
+struct Event {
+    size_t      mOffset;    ///< Offset in the static HTML
+    EventKind   mKind;      ///< Kind of event
+    size_t      mIndex;     ///< Index of the slot
+    size_t      mDepth;     ///< Indentation of the line, or of the child Element of an ElementSlot
+};
+
+/// Entity replacing a special character, or nullptr
+constexpr const char* entity(const char aChar) {
+    return ('&' == aChar) ? "&amp;" : ('<' == aChar) ? "&lt;" : ('>' == aChar) ? "&gt;" : ('"' == aChar) ? "&quot;"
+                          : nullptr;
+}
+
+/// Compile-time output only measuring the static HTML, to size the Compiled arrays
+struct Measure {
+    size_t mSize = 0;       ///< Length of the static HTML, without indentation nor end of line
+    size_t mNbEvents = 0;   ///< Number of indentations, ends of line and slots
+    size_t mNbSlots = 0;    ///< Highest slot index plus one
+
+    constexpr void put(char) {
+        ++mSize;
+    }
+    constexpr void put(const char* apString) {
+        mSize += length(apString);
+    }
+    constexpr void putEscaped(const char* apString) {
+        for (; *apString; ++apString) {
+            mSize += entity(*apString) ? length(entity(*apString)) : 1;
+        }
+    }
+    constexpr void indent(size_t) {
+        ++mNbEvents;
+    }
+    constexpr void endline() {
+        ++mNbEvents;
+    }
+    constexpr void slot(EventKind, const size_t aIndex, size_t) {
+        ++mNbEvents;
+        mNbSlots = (aIndex + 1 > mNbSlots) ? aIndex + 1 : mNbSlots;
+    }
+};
+
+/**
+ * @brief Static HTML generated at compile time without any layout, with the positions of its lines and slots.
+ *
+ * @tparam N    Length of the static HTML
+ * @tparam E    Number of indentations, ends of line and slots
+ */
+template<size_t N, size_t E>
+struct Compiled {
+    char    mHtml[N + 1] = {};
+    Event   mEvents[E + 1] = {};
+    size_t  mSize = 0;
+    size_t  mNbEvents = 0;
+    size_t  mNbSlots = 0;
+
+    constexpr void put(const char aChar) {
+        mHtml[mSize++] = aChar;
+    }
+    constexpr void put(const char* apString) {
+        for (; *apString; ++apString) {
+            put(*apString);
+        }
+    }
+    constexpr void putEscaped(const char* apString) {
+        for (; *apString; ++apString) {
+            if (entity(*apString)) {
+                put(entity(*apString));
+            } else {
+                put(*apString);
+            }
+        }
+    }
+    constexpr void indent(const size_t aIndentation) {
+        mEvents[mNbEvents++] = Event{mSize, EventKind::Indent, 0, aIndentation};
+    }
+    constexpr void endline() {
+        mEvents[mNbEvents++] = Event{mSize, EventKind::EndLine, 0, 0};
+    }
+    constexpr void slot(const EventKind aKind, const size_t aIndex, const size_t aDepth) {
+        mEvents[mNbEvents++] = Event{mSize, aKind, aIndex, aDepth};
+        mNbSlots = (aIndex + 1 > mNbSlots) ? aIndex + 1 : mNbSlots;
+    }
+};
+
+// Attributes of a node: all other arguments are ignored
+template<typename Out, typename T>
+constexpr void writeAttribute(Out&, const T&) {}
+template<typename Out>
+constexpr void writeAttribute(Out& aOut, const Attribute& aAttribute) {
+    aOut.put(' ');
+    aOut.put(aAttribute.mpName);
+    if (aAttribute.mpValue[0]) {
+        aOut.put("=\"");
+        aOut.putEscaped(aAttribute.mpValue);
+        aOut.put('"');
+    }
+}
+template<typename Out>
+constexpr void writeAttribute(Out& aOut, const AttributeSlot& aSlot) {
+    aOut.put(' ');
+    aOut.put(aSlot.mpName);
+    aOut.put("=\"");
+    aOut.slot(EventKind::Attribute, aSlot.mIndex, 0);
+    aOut.put('"');
+}
+
+// Text content of a node: the string literal arguments
+template<typename T>
+constexpr size_t contentSize(const T&) {
+    return 0;
+}
+constexpr size_t contentSize(const char* apContent) {
+    return length(apContent);
+}
+template<typename Out, typename T>
+constexpr void writeContent(Out&, const T&) {}
+template<typename Out>
+constexpr void writeContent(Out& aOut, const char* apContent) {
+    aOut.putEscaped(apContent);
+}
+
+// Children of a node: nodes, text nodes and slots of text and Element
+template<typename T>
+constexpr size_t childCount(const T&) {
+    return 0;
+}
+template<typename... Args>
+constexpr size_t childCount(const Node<Args...>&) {
+    return 1;
+}
+constexpr size_t childCount(const Text&) {
+    return 1;
+}
+constexpr size_t childCount(const TextSlot&) {
+    return 1;
+}
+constexpr size_t childCount(const ElementSlot&) {
+    return 1;
+}
+template<typename Out, typename... Args>
+constexpr void writeNode(Out& aOut, const Node<Args...>& aNode, size_t aIndentation);
+template<typename Out, typename T>
+constexpr void writeChild(Out&, const T&, size_t) {}
+template<typename Out, typename... Args>
+constexpr void writeChild(Out& aOut, const Node<Args...>& aNode, const size_t aIndentation) {
+    writeNode(aOut, aNode, aIndentation);
+}
+template<typename Out>
+constexpr void writeChild(Out& aOut, const Text& aText, const size_t aIndentation) {
+    aOut.indent(aIndentation);
+    aOut.putEscaped(aText.mpContent);
+    aOut.endline();
+}
+template<typename Out>
+constexpr void writeChild(Out& aOut, const TextSlot& aSlot, const size_t aIndentation) {
+    aOut.indent(aIndentation);
+    aOut.slot(EventKind::Text, aSlot.mIndex, aIndentation);
+    aOut.endline();
+}
+template<typename Out>
+constexpr void writeChild(Out& aOut, const ElementSlot& aSlot, const size_t aIndentation) {
+    aOut.slot(EventKind::Element, aSlot.mIndex, aIndentation);
+}
+
+// Iterations over the list of arguments of a node
+template<typename Out>
+constexpr void writeAttributes(Out&, const List<>&) {}
+template<typename Out, typename Head, typename... Tail>
+constexpr void writeAttributes(Out& aOut, const List<Head, Tail...>& aList) {
+    writeAttribute(aOut, aList.mHead);
+    writeAttributes(aOut, aList.mTail);
+}
+constexpr size_t contentSizes(const List<>&) {
+    return 0;
+}
+template<typename Head, typename... Tail>
+constexpr size_t contentSizes(const List<Head, Tail...>& aList) {
+    return contentSize(aList.mHead) + contentSizes(aList.mTail);
+}
+template<typename Out>
+constexpr void writeContents(Out&, const List<>&) {}
+template<typename Out, typename Head, typename... Tail>
+constexpr void writeContents(Out& aOut, const List<Head, Tail...>& aList) {
+    writeContent(aOut, aList.mHead);
+    writeContents(aOut, aList.mTail);
+}
+constexpr size_t childCounts(const List<>&) {
+    return 0;
+}
+template<typename Head, typename... Tail>
+constexpr size_t childCounts(const List<Head, Tail...>& aList) {
+    return childCount(aList.mHead) + childCounts(aList.mTail);
+}
+template<typename Out>
+constexpr void writeChildren(Out&, const List<>&, size_t) {}
+template<typename Out, typename Head, typename... Tail>
+constexpr void writeChildren(Out& aOut, const List<Head, Tail...>& aList, const size_t aIndentation) {
+    writeChild(aOut, aList.mHead, aIndentation);
+    writeChildren(aOut, aList.mTail, aIndentation);
+}
+
+/// Same serialization as Element::toStringOpen(), toStringContent() and toStringClose()
+template<typename Out, typename... Args>
+constexpr void writeNode(Out& aOut, const Node<Args...>& aNode, const size_t aIndentation) {
+    const bool bContent = (contentSizes(aNode.mArgs) > 0);
+    const bool bChildren = (childCounts(aNode.mArgs) > 0);
+    aOut.indent(aIndentation);
+    aOut.put('<');
+    aOut.put(aNode.mpName);
+    writeAttributes(aOut, aNode.mArgs);
+    aOut.put('>');
+    if (!bContent && (bChildren || aNode.mbVoid)) {
+        aOut.endline();
+    }
+    writeContents(aOut, aNode.mArgs);
+    writeChildren(aOut, aNode.mArgs, aIndentation + Pretty::Indentation);
+    if (bChildren) {
+        aOut.indent(aIndentation);
+    }
+    if (bContent || bChildren || !aNode.mbVoid) {
+        aOut.put("</");
+        aOut.put(aNode.mpName);
+        aOut.put('>');
+        aOut.endline();
+    }
+}
+
+/// Measure the static HTML of a tree, see HTML_STATIC()
+template<typename Tree>
+constexpr Measure measure(const Tree& aTree) {
+    Measure result;
+    writeNode(result, aTree, 0);
+    return result;
+}
+
+/// Generate the static HTML of a tree, see HTML_STATIC()
+template<size_t N, size_t E, typename Tree>
+constexpr Compiled<N, E> compile(const Tree& aTree) {
+    Compiled<N, E> compiled;
+    writeNode(compiled, aTree, 0);
+    return compiled;
+}
+
+} // namespace Static
+
+/// Generate at compile time the static HTML of a constexpr tree built with HTML::Static::tag()
+#define HTML_STATIC(tree) \
+    ::HTML::Static::compile< ::HTML::Static::measure(tree).mSize, ::HTML::Static::measure(tree).mNbEvents>(tree)
+
+/**
+ * @brief Element inserting some static HTML generated at compile time by HTML_STATIC(), with runtime slot values.
+ *
+ *   The static parts are written with a few memcpy in the layout of the Document, with their indentation rebased
+ * to the insertion depth,
+ * and the slot values are escaped and inserted at their position. A slot without a value is left empty,
+ * the markup around it being fixed at compile time.
+ *
+ * @warning The compiled HTML is referenced, not copied: it has to be a static constexpr constant.
+ */
+class StaticMarkup : public Element {
+public:
+    template<size_t N, size_t E>
+    explicit StaticMarkup(const Static::Compiled<N, E>& aCompiled) : Element(""_name) {
+        mpRenderable = std::make_shared<Instance>(aCompiled.mHtml, aCompiled.mSize, aCompiled.mEvents,
+                                                  aCompiled.mNbEvents, aCompiled.mNbSlots);
+    }
+
+    /// Set the value of a text or attribute slot
+    StaticMarkup&& set(const size_t aSlot, std::string aValue) {
+        Instance& instance = mutableInstance();
+        if (aSlot < instance.mTexts.size()) {
+            instance.mTexts[aSlot] = std::move(aValue);
+        }
+        return std::move(*this);
+    }
+    StaticMarkup&& set(const size_t aSlot, const char* apValue) {
+        return set(aSlot, std::string(apValue ? apValue : ""));
+    }
+    /// Set the child Element of an Element slot
+    StaticMarkup&& set(const size_t aSlot, Element&& aElement) {
+        Instance& instance = mutableInstance();
+        if (aSlot < instance.mElements.size()) {
+            instance.mElements[aSlot] = std::make_shared<const Element>(std::move(aElement));
+        }
+        return std::move(*this);
+    }
+
+    /// Empty all the slots, keeping the static HTML, like Element::clear()
+    StaticMarkup&& clear() {
+        Instance& instance = mutableInstance();
+        for (auto& text : instance.mTexts) {
+            text.clear();
+        }
+        for (auto& pElement : instance.mElements) {
+            pElement.reset();
+        }
+        return std::move(*this);
+    }
+
+private:
+    /// Reference to the static HTML, and runtime values of the slots
+    struct Instance : public Renderable {
+        Instance(const char* apHtml, const size_t aSize, const Static::Event* apEvents,
+                 const size_t aNbEvents, const size_t aNbSlots) :
+            mpHtml(apHtml), mSize(aSize), mpEvents(apEvents), mNbEvents(aNbEvents),
+            mTexts(aNbSlots), mElements(aNbSlots) {}
+
+        void render(Writer& aWriter, const size_t aIndentation) const override {
+            WriterOutput output(aWriter);
+            size_t begin = 0;
+            for (size_t idx = 0; idx < mNbEvents; ++idx) {
+                const Static::Event& event = mpEvents[idx];
+                aWriter.appendStable(mpHtml + begin, event.mOffset - begin);
+                begin = event.mOffset;
+                switch (event.mKind) {
+                case Static::EventKind::Indent:
+                    aWriter.indent(aIndentation + event.mDepth);
+                    break;
+                case Static::EventKind::EndLine:
+                    aWriter.endline();
+                    break;
+                case Static::EventKind::Text:
+                case Static::EventKind::Attribute:
+                    appendEscaped(output, mTexts[event.mIndex].data(), mTexts[event.mIndex].size());
+                    break;
+                case Static::EventKind::Element:
+                    if (mElements[event.mIndex]) {
+                        mElements[event.mIndex]->renderTo(aWriter, aIndentation + event.mDepth);
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+            aWriter.appendStable(mpHtml + begin, mSize - begin);
+        }
+
+        const char*                                 mpHtml;     ///< Static HTML, generated at compile time
+        size_t                                      mSize;      ///< Length of the static HTML
+        const Static::Event*                        mpEvents;   ///< Position of the lines and slots
+        size_t                                      mNbEvents;  ///< Number of indentations, ends of line and slots
+        std::vector<std::string>                    mTexts;     ///< Values of the text and attribute slots
+        std::vector<std::shared_ptr<const Element>> mElements;  ///< Child Elements of the Element slots
+    };
+
+    /// Instance to set slot values, copied first if it is already shared with another Element
+    Instance& mutableInstance() {
+        const Instance& instance = static_cast<const Instance&>(*mpRenderable);
+        if (mpRenderable.use_count() != 1) {
+            mpRenderable = std::make_shared<Instance>(instance);
+        }
+        // The Instance is created non-const by this class, and is not shared
+        return const_cast<Instance&>(static_cast<const Instance&>(*mpRenderable));
+    }
+};
+
+} // namespace HTML
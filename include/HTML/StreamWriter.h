@@ -0,0 +1,214 @@
+/**
+ * @file    StreamWriter.h
+ * @ingroup HtmlBuilder
+ * @brief   Incremental writer of a Document, serializing and discarding Elements one at a time.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Document.h"
+#include "Sink.h"
+
+#include <string>
+#include <vector>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Incremental writer of a Document, for pages too large to be held in memory.
+ *
+ *   The \<!DOCTYPE\>, the \<head\> and the opening tags of the Document are written at construction,
+ * then each Element is serialized as soon as it is given to the writer, so it can be discarded right away.
+ * Opening tags are closed on finish(). The output is byte-identical to Document::toString(aFormat) for the same content.
+ *
+ * @code
+    HTML::StreamSink sink(std::cout);
+    HTML::StreamWriter writer(sink, HTML::Document("Export"));
+    writer << HTML::Header1("Million rows");
+    writer.open(HTML::Table().cls("table"));
+    for (const auto& record : records) {
+        writer << (HTML::Row() << HTML::Col(record.name) << HTML::Col(record.value));
+    }
+    writer.close(); // </table>
+    writer.finish(); // </body></html>
+ * @endcode
+ */
+class StreamWriter {
+public:
+    static const size_t DefaultFlushSize = 64 * 1024;
+
+    /**
+     * @brief Write the beginning of the Document: \<!DOCTYPE\>, \<html\>, the full \<head\> and \<body\> opening tag.
+     *
+     * @param[in] aSink         Destination of the generated HTML
+     * @param[in] aDocument     Skeleton of the Document, with its \<head\> and optionally the first Elements of the body
+     * @param[in] aFlushSize    Size of the internal buffer above which it is flushed to the sink
+     * @param[in] aFormat       Layout of the generated HTML
+     */
+    StreamWriter(Sink& aSink, const Document& aDocument, const size_t aFlushSize = DefaultFlushSize,
+                 const Format aFormat = Format::Pretty) :
+        mSink(aSink), mFlushSize(aFlushSize), mFormat(aFormat) {
+        mBuffer.reserve(aFlushSize);
+        Element::append(mBuffer, "<!DOCTYPE html>");
+        endline();
+        if (Format::Minified == mFormat) {
+            aDocument.toStringTag<Minified>(mBuffer, 0);
+        } else {
+            aDocument.toStringTag<Pretty>(mBuffer, 0);
+        }
+        tagEndline();
+        mFrames.push_back({aDocument.mName, 0, false, true, aDocument.mbVoid, false});
+        render(aDocument.head(), Pretty::Indentation);
+        openFrame(aDocument.body(), Pretty::Indentation);
+        flushIfFull();
+    }
+
+    /// Serialize an Element as the next child of the innermost opened Element (the \<body\> by default)
+    StreamWriter& operator<<(const Element& aElement) {
+        Frame& frame = mFrames.back();
+        if (frame.mbEndlineOwed) {
+            endline();
+            frame.mbEndlineOwed = false;
+        }
+        frame.mbChildren = true;
+        render(aElement, frame.mIndentation + Pretty::Indentation);
+        flushIfFull();
+        return *this;
+    }
+    StreamWriter& operator<<(const char* apContent) {
+        return *this << Text(apContent);
+    }
+    StreamWriter& operator<<(const std::string& aContent) {
+        return *this << Text(aContent);
+    }
+
+    /**
+     * @brief Serialize the opening tag of a named Element, and its content and children if any.
+     *
+     *   The Elements written afterward are its children, until close() is called.
+     */
+    StreamWriter& open(const Element& aElement) {
+        Frame& frame = mFrames.back();
+        if (frame.mbEndlineOwed) {
+            endline();
+            frame.mbEndlineOwed = false;
+        }
+        frame.mbChildren = true;
+        openFrame(aElement, frame.mIndentation + Pretty::Indentation);
+        flushIfFull();
+        return *this;
+    }
+
+    /// Serialize the closing tag of the innermost Element opened with open()
+    StreamWriter& close() {
+        if (mFrames.size() > 2) {
+            closeFrame();
+            flushIfFull();
+        }
+        return *this;
+    }
+
+    /// Send the buffered HTML to the sink
+    void flush() {
+        if (!mBuffer.empty()) {
+            mSink.write(mBuffer.data(), mBuffer.size());
+            mBuffer.clear();
+        }
+    }
+
+    /// Close all opened Elements, including \<body\> and \<html\>, and flush the end of the Document to the sink
+    void finish() {
+        while (!mFrames.empty()) {
+            closeFrame();
+        }
+        flush();
+    }
+
+private:
+    /// State of an opened Element, required to generate its closing tag exactly like Element::toStringClose()
+    struct Frame {
+        Name    mName;
+        size_t  mIndentation;
+        bool    mbContent;      ///< The Element has text content
+        bool    mbChildren;     ///< The Element has at least a child
+        bool    mbVoid;         ///< The Element is a self-closing one
+        bool    mbEndlineOwed;  ///< The end of line of the opening tag is only written with the first child
+    };
+
+    void openFrame(const Element& aElement, const size_t aIndentation) {
+        Frame frame = {aElement.mName, aIndentation, !aElement.mContent.empty(), !aElement.mChildren.empty(),
+                       aElement.mbVoid, false};
+        if (Format::Minified == mFormat) {
+            aElement.toStringTag<Minified>(mBuffer, aIndentation);
+        } else {
+            aElement.toStringTag<Pretty>(mBuffer, aIndentation);
+        }
+        if (frame.mbContent) {
+            mBuffer += '>';
+            aElement.toStringText(mBuffer);
+        } else if (frame.mbChildren || frame.mbVoid) {
+            tagEndline();
+        } else {
+            mBuffer += '>';
+            frame.mbEndlineOwed = true;
+        }
+        for (const auto& child : aElement.mChildren) {
+            render(child, aIndentation + Pretty::Indentation);
+        }
+        mFrames.push_back(frame);
+    }
+
+    void closeFrame() {
+        const Frame& frame = mFrames.back();
+        if (frame.mbChildren && (Format::Pretty == mFormat)) {
+            Pretty::indent(mBuffer, frame.mIndentation);
+        }
+        if (frame.mbContent || frame.mbChildren || !frame.mbVoid) {
+            Element::append(mBuffer, "</");
+            mBuffer.append(frame.mName.data(), frame.mName.size());
+            tagEndline();
+        }
+        mFrames.pop_back();
+    }
+
+    /// Serialize an Element with the layout of the writer
+    void render(const Element& aElement, const size_t aIndentation) {
+        if (Format::Minified == mFormat) {
+            aElement.render<Minified>(mBuffer, aIndentation);
+        } else {
+            aElement.render<Pretty>(mBuffer, aIndentation);
+        }
+    }
+    void endline() {
+        if (Format::Pretty == mFormat) {
+            Pretty::endline(mBuffer);
+        }
+    }
+    void tagEndline() {
+        if (Format::Minified == mFormat) {
+            Minified::tagEndline(mBuffer);
+        } else {
+            Pretty::tagEndline(mBuffer);
+        }
+    }
+
+    void flushIfFull() {
+        if (mBuffer.size() >= mFlushSize) {
+            flush();
+        }
+    }
+
+private:
+    Sink&               mSink;      ///< Destination of the generated HTML
+    std::string         mBuffer;    ///< Generated HTML not yet sent to the sink
+    const size_t        mFlushSize; ///< Size of the buffer above which it is flushed to the sink
+    const Format        mFormat;    ///< Layout of the generated HTML
+    std::vector<Frame>  mFrames;    ///< Stack of opened Elements, starting with \<html\> and \<body\>
+};
+
+} // namespace HTML
@@ -0,0 +1,182 @@
+/**
+ * @file    Table.h
+ * @ingroup HtmlBuilder
+ * @brief   Elements of a \<table\>: rows, columns, headers and caption.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Element.h"
+
+#include <string>
+#include <utility>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/// \<th\> Table Header Column Element
+class ColHeader : public Element {
+public:
+    explicit ColHeader(const char* apContent = nullptr) : Element("th"_name, apContent) {}
+    explicit ColHeader(std::string&& aContent) : Element("th"_name, std::move(aContent)) {}
+    explicit ColHeader(const std::string& aContent) : Element("th"_name, aContent) {}
+
+    ColHeader&& operator<<(Element&& aElement) {
+        mChildren.push_back(std::move(aElement));
+        return std::move(*this);
+    }
+
+    ColHeader&& rowSpan(const unsigned int aNbRow) {
+        if (0 < aNbRow) {
+            addAttribute("rowspan"_name, aNbRow);
+        }
+        return std::move(*this);
+    }
+    ColHeader&& colSpan(const unsigned int aNbCol) {
+        if (0 < aNbCol) {
+            addAttribute("colspan"_name, aNbCol);
+        }
+        return std::move(*this);
+    }
+};
+
+/// \<td\> Table Column Element
+class Col : public Element {
+public:
+    explicit Col(const char* apContent = nullptr) : Element("td"_name, apContent) {}
+    explicit Col(std::string&& aContent) : Element("td"_name, std::move(aContent)) {}
+    explicit Col(const std::string& aContent) : Element("td"_name, aContent) {}
+    /// Cell of a number (integer, floating-point or bool), like "42", "0.1" or "true"
+    template<typename T, typename = typename std::enable_if<IsNumber<T>::value>::type>
+    explicit Col(const T aValue) : Element("td"_name, Number(aValue).str()) {}
+    /// Cell of a floating-point number, with the given notation and precision, like "3.14" for FloatFormat::fixed(2)
+    Col(const double aValue, const FloatFormat aFormat) : Element("td"_name, Number(aValue, aFormat).str()) {}
+
+    Col&& operator<<(Element&& aElement) {
+        mChildren.push_back(std::move(aElement));
+        return std::move(*this);
+    }
+
+    Col&& rowSpan(const unsigned int aNbRow) {
+        if (0 < aNbRow) {
+            addAttribute("rowspan"_name, aNbRow);
+        }
+        return std::move(*this);
+    }
+    Col&& colSpan(const unsigned int aNbCol) {
+        if (0 < aNbCol) {
+            addAttribute("colspan"_name, aNbCol);
+        }
+        return std::move(*this);
+    }
+    Col&& style(std::string aValue) {
+        Element::style(std::move(aValue));
+        return std::move(*this);
+    }
+};
+
+/// \<tr\> Table Row Element
+class Row : public Element {
+public:
+    Row() : Element("tr"_name) {}
+
+    Row&& operator<<(Element&& aElement) {
+        mChildren.push_back(std::move(aElement));
+        return std::move(*this);
+    }
+
+    Row&& operator<<(ColHeader&& aCol) {
+        mChildren.push_back(std::move(aCol));
+        return std::move(*this);
+    }
+    Row&& operator<<(Col&& aCol) {
+        mChildren.push_back(std::move(aCol));
+        return std::move(*this);
+    }
+    Row&& style(std::string aValue) {
+        Element::style(std::move(aValue));
+        return std::move(*this);
+    }
+
+    Row&& reserve(const size_t aNbCols) {
+        Element::reserve(aNbCols);
+        return std::move(*this);
+    }
+    /// Append a Col for each value of a range: strings, or Col Elements (use std::make_move_iterator to move them)
+    template<typename Iterator>
+    Row&& addCols(const Iterator aBegin, const Iterator aEnd) {
+        appendRange<Col>(mChildren, aBegin, aEnd);
+        return std::move(*this);
+    }
+    template<typename Range>
+    Row&& addCols(const Range& aRange) {
+        return addCols(std::begin(aRange), std::end(aRange));
+    }
+};
+
+/// \<caption\> Table Caption Element
+class Caption : public Element {
+public:
+    explicit Caption(const char* apContent) : Element("caption"_name, apContent) {}
+};
+
+/// \<table\> Element
+class Table : public Element {
+public:
+    Table() : Element("table"_name) {}
+
+    Table&& operator<<(Element&& aElement) = delete;
+    Table&& operator<<(Slot&& aSlot) {
+        mChildren.push_back(std::move(aSlot));
+        return std::move(*this);
+    }
+    Table&& operator<<(Shared&& aShared) {
+        mChildren.push_back(std::move(aShared));
+        return std::move(*this);
+    }
+    Table&& operator<<(Row&& aRow) {
+        mChildren.push_back(std::move(aRow));
+        return std::move(*this);
+    }
+    Table&& operator<<(Caption&& aCaption) {
+        mChildren.push_back(std::move(aCaption));
+        return std::move(*this);
+    }
+
+    Table&& reserve(const size_t aNbRows) {
+        Element::reserve(aNbRows);
+        return std::move(*this);
+    }
+    /**
+     * @brief Append a Row for each record of a range of records, with a Col for each value of a record.
+     *
+     *   A record is a Row Element (use std::make_move_iterator to move them), or a range of strings
+     * like a std::vector<std::string>.
+     */
+    template<typename Iterator>
+    Table&& addRows(const Iterator aBegin, const Iterator aEnd) {
+        appendRange<RecordRow>(mChildren, aBegin, aEnd);
+        return std::move(*this);
+    }
+    template<typename Range>
+    Table&& addRows(const Range& aRange) {
+        return addRows(std::begin(aRange), std::end(aRange));
+    }
+
+private:
+    /// Row built from a Row, or from a range of values
+    struct RecordRow : public Row {
+        explicit RecordRow(const Row& aRow) : Row(aRow) {}
+        explicit RecordRow(Row&& aRow) : Row(std::move(aRow)) {}
+        template<typename Record>
+        explicit RecordRow(const Record& aRecord) {
+            addCols(aRecord);
+        }
+    };
+};
+
+} // namespace HTML
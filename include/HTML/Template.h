@@ -0,0 +1,211 @@
+/**
+ * @file    Template.h
+ * @ingroup HtmlBuilder
+ * @brief   Pre-rendered Document with named Slots, serialized again by only rendering the slots modified since.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Document.h"
+#include "Hash.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Document pre-rendered once around its Slots, then serialized by splicing the cached HTML with the slots.
+ *
+ *   The HTML between the Slots is generated once, for the layout given at construction. The content of each Slot
+ * is rendered at the next serialization after it is set, and cached until set again, so a page that is mostly
+ * identical between requests costs a few memcpy and the rendering of the slots that changed.
+ * The output is identical to the one of the Document with the same content in its Slots.
+ *
+ * @code
+    HTML::Document page("Dashboard");
+    page << (HTML::Header1("Welcome ") << HTML::Slot("user")) << (HTML::Table() << HTML::Slot("rows"));
+    HTML::Template dashboard(page);
+    dashboard.set("user", user.name()).set("rows", buildRows(orders));
+    send(dashboard.toString());
+ * @endcode
+ *
+ * @warning The Slots are searched in the Element tree only: not in the Fragments, Deferred or other custom content,
+ *          rendered once with the static HTML. A Template is not thread-safe, since it caches the HTML of the slots.
+ */
+class Template {
+public:
+    /// Pre-render a whole Document, starting with its \<!DOCTYPE\>
+    explicit Template(const Document& aDocument, const Format aFormat = Format::Pretty) : mFormat(aFormat) {
+        if (Format::Minified == mFormat) {
+            Element::append(mStatic, "<!DOCTYPE html>");
+            Minified::endline(mStatic);
+            compile<Minified>(aDocument, 0);
+        } else {
+            Element::append(mStatic, "<!DOCTYPE html>");
+            Pretty::endline(mStatic);
+            compile<Pretty>(aDocument, 0);
+        }
+    }
+    /// Pre-render an Element and its children
+    explicit Template(const Element& aElement, const Format aFormat = Format::Pretty) : mFormat(aFormat) {
+        if (Format::Minified == mFormat) {
+            compile<Minified>(aElement, 0);
+        } else {
+            compile<Pretty>(aElement, 0);
+        }
+    }
+
+    /// Set the content of the Slots of the given name, rendered at the next serialization; other names are ignored
+    Template& set(const Name& aName, Element&& aContent) {
+        return set(aName, std::make_shared<const Element>(std::move(aContent)));
+    }
+    /// Set the text of the Slots of the given name, with special characters escaped
+    Template& set(const Name& aName, std::string aText) {
+        return set(aName, Text(std::move(aText)));
+    }
+    /// Empty the Slots of the given name
+    Template& clear(const Name& aName) {
+        return set(aName, std::shared_ptr<const Element>());
+    }
+
+    /// Has a Slot of the given name been set since the last serialization
+    bool isDirty(const Name& aName) const {
+        for (const auto& slot : mSlots) {
+            if ((slot.mName == aName) && slot.mbDirty) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// Serialize the Template, rendering the Slots set since the last serialization
+    std::string toString() {
+        std::string buffer;
+        buffer.reserve(renderedSize());
+        appendTo(buffer);
+        return buffer;
+    }
+
+    /**
+     * @brief Serialize the Template at the end of a caller-owned buffer, like Element::appendTo().
+     *
+     * @param[in,out] aBuffer   Buffer to append the generated HTML to, or any Output like a VectoredOutput
+     *
+     * @return the buffer, to chain calls
+     */
+    template<typename Output>
+    Output& appendTo(Output& aBuffer) {
+        update();
+        size_t begin = 0;
+        for (const auto& slot : mSlots) {
+            aBuffer.append(mStatic.data() + begin, slot.mOffset - begin);
+            aBuffer.append(slot.mHtml.data(), slot.mHtml.size());
+            begin = slot.mOffset;
+        }
+        aBuffer.append(mStatic.data() + begin, mStatic.size() - begin);
+        return aBuffer;
+    }
+
+    /**
+     * @brief Hash of the next serialization (see ContentHash), computed again only after a Slot has been set.
+     *
+     *   While no Slot is set, the ETag of the page is known without generating nor hashing it,
+     * so a conditional request is answered before any rendering.
+     */
+    uint64_t contentHash() {
+        if (!mbHashed) {
+            ContentHash hash;
+            appendTo(hash);
+            mHash = hash.digest();
+            mbHashed = true;
+        }
+        return mHash;
+    }
+    /// Strong ETag of the next serialization, see contentHash()
+    std::string etag() {
+        return ContentHash::toETag(contentHash());
+    }
+
+    /// Compute the exact number of characters of the next serialization, rendering the Slots set since the last one
+    size_t renderedSize() {
+        update();
+        size_t size = mStatic.size();
+        for (const auto& slot : mSlots) {
+            size += slot.mHtml.size();
+        }
+        return size;
+    }
+
+private:
+    /// Position of a Slot in the static HTML, with the cache of its content
+    struct SlotState {
+        Name                            mName;          ///< Name of the Slot
+        size_t                          mOffset;        ///< Offset of the Slot in the static HTML
+        size_t                          mIndentation;   ///< Indentation of the content of the Slot
+        std::shared_ptr<const Element>  mpContent;      ///< Content of the Slot, if any
+        std::string                     mHtml;          ///< HTML of the content, cached until set again
+        bool                            mbDirty;        ///< The content has been set since the last serialization
+    };
+
+    /// Generate the static HTML of the Element and of its children, recording the position of the Slots
+    template<typename Layout>
+    void compile(const Element& aElement, const size_t aIndentation) {
+        if (aElement.mbSlot) {
+            const Slot::Content& content = static_cast<const Slot::Content&>(*aElement.mpRenderable);
+            mSlots.push_back(SlotState{content.mName, mStatic.size(), aIndentation, content.mpDefault,
+                                       std::string(), true});
+        } else if (aElement.mpRenderable || aElement.mName.empty()) {
+            aElement.render<Layout>(mStatic, aIndentation);
+        } else {
+            aElement.toStringOpen<Layout>(mStatic, aIndentation);
+            aElement.toStringText(mStatic);
+            for (const auto& child : aElement.mChildren) {
+                compile<Layout>(child, aIndentation + Layout::Indentation);
+            }
+            aElement.toStringClose<Layout>(mStatic, aIndentation);
+        }
+    }
+
+    Template& set(const Name& aName, const std::shared_ptr<const Element>& apContent) {
+        for (auto& slot : mSlots) {
+            if (slot.mName == aName) {
+                slot.mpContent = apContent;
+                slot.mbDirty = true;
+                mbHashed = false;
+            }
+        }
+        return *this;
+    }
+
+    /// Render the Slots set since the last serialization
+    void update() {
+        for (auto& slot : mSlots) {
+            if (slot.mbDirty) {
+                slot.mHtml.clear();
+                if (slot.mpContent && (Format::Minified == mFormat)) {
+                    slot.mpContent->appendTo<Minified>(slot.mHtml, slot.mIndentation);
+                } else if (slot.mpContent) {
+                    slot.mpContent->appendTo<Pretty>(slot.mHtml, slot.mIndentation);
+                }
+                slot.mbDirty = false;
+            }
+        }
+    }
+
+private:
+    const Format            mFormat;            ///< Layout of the generated HTML
+    std::string             mStatic;            ///< HTML generated once, around the Slots
+    std::vector<SlotState>  mSlots;             ///< Slots, in the order of the HTML
+    uint64_t                mHash = 0;          ///< Hash of the serialization, cached until a Slot is set
+    bool                    mbHashed = false;   ///< The hash is up to date
+};
+
+} // namespace HTML
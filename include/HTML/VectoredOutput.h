@@ -0,0 +1,177 @@
+/**
+ * @file    VectoredOutput.h
+ * @ingroup HtmlBuilder
+ * @brief   Output referring to the strings of the Elements instead of copying them, flushed to a Sink with writev().
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+#pragma once
+
+#include "Element.h"
+#include "Sink.h"
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+/**
+ * @brief Output with the std::string append interface, building a list of IoSlice sent to a Sink::writev() in batches.
+ *
+ *   The content and attribute values of the Elements, the tag literals and the HTML of the frozen Fragments
+ * and of the StaticMarkup are large and stable until the end of the serialization, so they are referenced as is.
+ * Only the short strings (below aMinReferenceSize), the single characters, the indentation
+ * and the HTML generated on the fly by a Renderable are copied into a fixed buffer, contiguous ones sharing one slice.
+ * The slices are flushed when either the list or the buffer is full (and on flush()), with a single call to the Sink.
+ *
+ * @code
+    HTML::DescriptorSink sink(socket);
+    HTML::VectoredOutput output(sink);
+    document.appendTo<HTML::Minified>(output);
+    output.flush();
+ * @endcode
+ *
+ * @warning The Elements must not be modified (nor destroyed) until the output is flushed,
+ *          and the buffered slices are lost if it is destroyed before a flush().
+ */
+class VectoredOutput {
+public:
+    static const size_t DefaultMinReferenceSize = 128;
+    static const size_t DefaultBufferSize = 16 * 1024;
+    static const size_t DefaultMaxSlices = 1024;
+
+    /**
+     * @param[in] aSink             Destination of the generated HTML
+     * @param[in] aMinReferenceSize Size of the strings referenced instead of copied
+     * @param[in] aBufferSize       Size of the buffer of the short strings copied
+     * @param[in] aMaxSlices        Number of slices sent at once to the sink (IOV_MAX is 1024 on most systems)
+     */
+    explicit VectoredOutput(Sink& aSink, const size_t aMinReferenceSize = DefaultMinReferenceSize,
+                            const size_t aBufferSize = DefaultBufferSize, const size_t aMaxSlices = DefaultMaxSlices) :
+        mSink(aSink), mMinReferenceSize(aMinReferenceSize), mBufferSize(aBufferSize > 0 ? aBufferSize : 1),
+        mpBuffer(new char[mBufferSize]), mMaxSlices(aMaxSlices > 0 ? aMaxSlices : 1) {
+        mSlices.reserve(mMaxSlices);
+    }
+
+    /// Append a string staying valid and unchanged until the next flush(), referencing it unless it is short
+    VectoredOutput& append(const char* apData, const size_t aSize) {
+        if (aSize >= mMinReferenceSize) {
+            reference(apData, aSize);
+        } else {
+            copy(apData, aSize);
+        }
+        return *this;
+    }
+    /// Append the indentation
+    VectoredOutput& append(size_t aCount, char) {
+        static const char spaces[] = "                                                                ";
+        for (; aCount >= sizeof(spaces) - 1; aCount -= sizeof(spaces) - 1) {
+            copy(spaces, sizeof(spaces) - 1);
+        }
+        copy(spaces, aCount);
+        return *this;
+    }
+    VectoredOutput& operator+=(const char aChar) {
+        copy(&aChar, 1);
+        return *this;
+    }
+    VectoredOutput& operator+=(const std::string& aString) {
+        return append(aString.data(), aString.size());
+    }
+
+    /// Append a string that may change before the next flush(), like the HTML generated by a Renderable
+    void copy(const char* apData, size_t aSize) {
+        mSize += aSize;
+        while (aSize > 0) {
+            char* pEnd = mpBuffer.get() + mBufferUsed;
+            const bool bContiguous = !mSlices.empty() &&
+                                     (static_cast<char*>(mSlices.back().iov_base) + mSlices.back().iov_len == pEnd);
+            if ((mBufferUsed == mBufferSize) || (!bContiguous && (mSlices.size() == mMaxSlices))) {
+                flush();
+                continue;
+            }
+            const size_t size = (aSize < mBufferSize - mBufferUsed) ? aSize : (mBufferSize - mBufferUsed);
+            memcpy(pEnd, apData, size);
+            if (bContiguous) {
+                mSlices.back().iov_len += size;
+            } else {
+                push(pEnd, size);
+            }
+            mBufferUsed += size;
+            apData += size;
+            aSize -= size;
+        }
+    }
+
+    /// Size of the HTML appended so far, flushed or not
+    size_t size() const {
+        return mSize;
+    }
+
+    /// Send the slices of HTML to the sink, after which the Elements can be modified again
+    void flush() {
+        if (!mSlices.empty()) {
+            mSink.writev(mSlices.data(), mSlices.size());
+            mSlices.clear();
+        }
+        mBufferUsed = 0;
+    }
+
+private:
+    void reference(const char* apData, const size_t aSize) {
+        mSize += aSize;
+        if (mSlices.size() == mMaxSlices) {
+            flush();
+        }
+        push(const_cast<char*>(apData), aSize);
+    }
+    void push(char* apData, const size_t aSize) {
+        IoSlice slice;
+        slice.iov_base = apData;
+        slice.iov_len = aSize;
+        mSlices.push_back(slice);
+    }
+
+private:
+    Sink&                   mSink;              ///< Destination of the generated HTML
+    const size_t            mMinReferenceSize;  ///< Size of the strings referenced instead of copied
+    const size_t            mBufferSize;        ///< Size of the buffer of the short strings copied
+    std::unique_ptr<char[]> mpBuffer;           ///< Buffer of the short strings copied, referenced by the slices
+    size_t                  mBufferUsed = 0;    ///< Size of the buffer used since the last flush
+    const size_t            mMaxSlices;         ///< Number of slices sent at once to the sink
+    std::vector<IoSlice>    mSlices;            ///< Slices not yet sent to the sink
+    size_t                  mSize = 0;          ///< Size of the HTML appended
+};
+
+/// Writer given to the Renderable content of the Elements: only the HTML declared stable is referenced, not copied
+template<typename Layout>
+class OutputWriter<Layout, VectoredOutput> : public Writer {
+public:
+    /// Writer of a content rendered at aOrigin spaces of the layout (see layoutIndentation())
+    explicit OutputWriter(VectoredOutput& aOutput, const size_t aOrigin = 0) : mOutput(aOutput), mOrigin(aOrigin) {}
+
+    void append(const char* apData, size_t aSize) override {
+        mOutput.copy(apData, aSize);
+    }
+    void appendStable(const char* apData, size_t aSize) override {
+        mOutput.append(apData, aSize);
+    }
+    void indent(size_t aIndentation) override {
+        Layout::indent(mOutput, layoutIndentation<Layout>(mOrigin, aIndentation));
+    }
+    void endline() override {
+        Layout::endline(mOutput);
+    }
+
+private:
+    VectoredOutput& mOutput;
+    const size_t    mOrigin;    ///< Indentation of the content
+};
+
+} // namespace HTML
@@ -0,0 +1,76 @@
+/**
+ * @file    HtmlBuilder.cpp
+ * @ingroup HtmlBuilder
+ * @brief   Compiled HtmlBuilder library: the serialization of the Elements, instantiated once for all the programs.
+ *
+ *   The programs linked with the library define HTML_COMPILED_LIBRARY to 1, so their translation units only see
+ * the declarations of the serialization, and do not instantiate it again (see Render.h).
+ *
+ *   Only the Pretty, Minified and Observed layouts are instantiated: the translation units serializing
+ * with another layout policy (like a PrettyLayout<4>) include Render.h.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#ifndef HTML_COMPILED_LIBRARY
+#define HTML_COMPILED_LIBRARY 1
+#endif
+
+#include <HTML/HTML.h>
+#include <HTML/Render.h>
+
+#include <ostream>
+#include <string>
+
+/// A simple C++ HTML Generator library.
+namespace HTML {
+
+// Note: the names of an explicit instantiation are not subject to access checking, like ChunkedWriter::ChunkOutput
+
+// Serialization of the Elements and Documents, to the Outputs of the library
+#define HTML_INSTANTIATE_RENDER(Layout, Output) \
+    template void Element::render<Layout, Output>(Output& aBuffer, const size_t aIndentation) const;
+
+#define HTML_INSTANTIATE_LAYOUT(Layout) \
+    HTML_INSTANTIATE_RENDER(Layout, std::string) \
+    HTML_INSTANTIATE_RENDER(Layout, SizeCounter) \
+    HTML_INSTANTIATE_RENDER(Layout, VectoredOutput) \
+    HTML_INSTANTIATE_RENDER(Layout, ContentHash) \
+    HTML_INSTANTIATE_RENDER(Layout, HashingOutput) \
+    HTML_INSTANTIATE_RENDER(Layout, ChunkedWriter::ChunkOutput) \
+    template void Element::render<Layout>(std::string& aBuffer, const size_t aIndentation, \
+                                          const ParallelPolicy& aPolicy) const; \
+    template void Element::collectStats<Layout>(RenderStats& aStats, const size_t aIndentation, \
+                                                const size_t aDepth) const; \
+    template void Element::toStringTag<Layout, std::string>(std::string& aBuffer, const size_t aIndentation) const; \
+    template void Element::toStringOpen<Layout, std::string>(std::string& aBuffer, const size_t aIndentation) const; \
+    template void Element::toStringClose<Layout, std::string>(std::string& aBuffer, const size_t aIndentation) const; \
+    template void Element::toStringOpen<Layout, ChunkedWriter::ChunkOutput>(ChunkedWriter::ChunkOutput& aBuffer, \
+                                                                            const size_t aIndentation) const; \
+    template void Element::toStringClose<Layout, ChunkedWriter::ChunkOutput>(ChunkedWriter::ChunkOutput& aBuffer, \
+                                                                             const size_t aIndentation) const;
+
+HTML_INSTANTIATE_LAYOUT(Pretty)
+HTML_INSTANTIATE_LAYOUT(Minified)
+HTML_INSTANTIATE_LAYOUT(Observed<Pretty>)
+HTML_INSTANTIATE_LAYOUT(Observed<Minified>)
+
+// Serialization of a Fragment, and of the Elements given to a Writer by custom content
+HTML_INSTANTIATE_RENDER(WriterLayout, WriterOutput)
+
+// Text content of the Elements written by the StreamWriter, ChunkedWriter and Template
+template void Element::toStringText<std::string>(std::string& aBuffer) const;
+template void Element::toStringText<ChunkedWriter::ChunkOutput>(ChunkedWriter::ChunkOutput& aBuffer) const;
+
+#undef HTML_INSTANTIATE_LAYOUT
+#undef HTML_INSTANTIATE_RENDER
+
+std::ostream& operator<<(std::ostream& aStream, const Element& aElement) {
+    const std::string buffer = aElement.toString();
+    return aStream.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+} // namespace HTML
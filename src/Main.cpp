@@ -9,9 +9,8 @@
  * or copy at http://opensource.org/licenses/MIT)
  */
 
-// Note: to configure indentation & minification, define this at compile time before including HTML headers.
-#define HTML_INDENTATION 2 ///< Default indentation can be set to 0 to remove many spaces in generated HTML
-#define HTML_ENDLINE "\n" ///< End of lines can be removed to minimize even more the resulting generated HTML
+// Note: to configure the Pretty layout, serialize with a policy like toString<HTML::PrettyLayout<4>>().
+// To minify the generated HTML, prefer toString(HTML::Format::Minified) or toString<HTML::Minified>().
 
 #include <HTML/HTML.h>
 
@@ -0,0 +1,79 @@
+/**
+ * @file    DataTableTest.cpp
+ * @ingroup HtmlBuilder
+ * @brief   DataTable rendered like the equivalent Table, including without any row.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <HTML/HTML.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/// Report a failed check, returning the number of failures
+static int check(const bool abSuccess, const char* apWhat) {
+    if (!abSuccess) {
+        fprintf(stderr, "FAILED: %s\n", apWhat);
+    }
+    return abSuccess ? 0 : 1;
+}
+
+/// The same HTML in both layouts
+static int checkSame(const HTML::Element& aDataTable, const HTML::Element& aTable, const char* apWhat) {
+    return check((aDataTable.toString() == aTable.toString()) &&
+                 (aDataTable.toString(HTML::Format::Minified) == aTable.toString(HTML::Format::Minified)) &&
+                 (aDataTable.renderedSize() == aTable.renderedSize()), apWhat);
+}
+
+/**
+ * @brief Entry-point of the test, returning EXIT_FAILURE on any failed check.
+ */
+int main() {
+    int failures = 0;
+
+    // No row: the table has no child, like an empty Table
+    failures += checkSame(HTML::DataTable(), HTML::Table(), "no column");
+    HTML::DataTable noRow;
+    noRow.addColumn("", std::vector<std::string>()).colStyle("width:10%");
+    failures += checkSame(noRow, HTML::Table(), "columns without any row");
+
+    // Headers and values
+    HTML::DataTable dataTable;
+    dataTable.addColumn("Name", std::vector<std::string>{"a <b>", "c"});
+    dataTable.addColumn("Quantity", std::vector<long long>{1, -2});
+    dataTable.addColumn("", std::vector<std::string>{"x"}).colStyle("color:red");
+    HTML::Table table;
+    table << (HTML::Row() << HTML::ColHeader("Name") << HTML::ColHeader("Quantity") << HTML::ColHeader(""));
+    table << (HTML::Row() << HTML::Col("a <b>") << HTML::Col("1") << HTML::Col("x").style("color:red"));
+    table << (HTML::Row() << HTML::Col("c") << HTML::Col("-2") << HTML::Col("").style("color:red"));
+    failures += checkSame(dataTable, table, "headers and values");
+
+    // A column added to a copy of a table without any row leaves the original one empty
+    HTML::DataTable copy = noRow;
+    copy.addColumn("", std::vector<std::string>{"y"});
+    failures += checkSame(noRow, HTML::Table(), "original of a copy");
+    HTML::Table copyTable;
+    copyTable << (HTML::Row() << HTML::Col("").style("width:10%") << HTML::Col("y"));
+    failures += checkSame(copy, copyTable, "copy with a row");
+
+    // Cleared, then filled again
+    dataTable.clear();
+    failures += checkSame(dataTable, HTML::Table(), "cleared");
+    dataTable.addColumn("", std::vector<std::string>{"y"});
+    HTML::Table refilled;
+    refilled << (HTML::Row() << HTML::Col("y"));
+    failures += checkSame(dataTable, refilled, "filled again");
+
+    if (failures > 0) {
+        fprintf(stderr, "%d failed checks\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("DataTable: all checks passed\n");
+    return EXIT_SUCCESS;
+}
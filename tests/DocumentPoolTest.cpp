@@ -0,0 +1,92 @@
+/**
+ * @file    DocumentPoolTest.cpp
+ * @ingroup HtmlBuilder
+ * @brief   Arenas selected by the PooledDocuments of a thread, including when they are destroyed out of order.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <HTML/HTML.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+/// Report a failed check, returning the number of failures
+static int check(const bool abSuccess, const char* apWhat) {
+    if (!abSuccess) {
+        fprintf(stderr, "FAILED: %s\n", apWhat);
+    }
+    return abSuccess ? 0 : 1;
+}
+
+/// Page of a request
+static void buildPage(HTML::PooledDocument& aPage, const char* apText) {
+    *aPage << (HTML::Div("content") << HTML::Paragraph(apText));
+}
+
+/**
+ * @brief Entry-point of the test, returning EXIT_FAILURE on any failed check.
+ */
+int main() {
+    int failures = 0;
+    HTML::DocumentPool pool;
+    HTML::MemoryResource* const pGlobal = &HTML::currentResource();
+
+    // Destroyed in the order of their construction, like PooledDocuments held by different objects
+    std::unique_ptr<HTML::PooledDocument> pFirst(new HTML::PooledDocument("First", pool));
+    HTML::MemoryResource* const pFirstArena = &HTML::currentResource();
+    buildPage(*pFirst, "first");
+    std::unique_ptr<HTML::PooledDocument> pSecond(new HTML::PooledDocument("Second", pool));
+    HTML::MemoryResource* const pSecondArena = &HTML::currentResource();
+    buildPage(*pSecond, "second");
+    failures += check((pFirstArena != pGlobal) && (pSecondArena != pFirstArena), "arena of each PooledDocument");
+
+    pFirst.reset();
+    failures += check(&HTML::currentResource() == pSecondArena, "arena of the PooledDocument still alive");
+    failures += check(1 == pool.available(), "arena of the first PooledDocument recycled");
+    buildPage(*pSecond, "more");
+    failures += check((*pSecond)->toString().find("more") != std::string::npos, "page built after the first one");
+
+    pSecond.reset();
+    failures += check(&HTML::currentResource() == pGlobal, "global heap once both are destroyed");
+    failures += check(2 == pool.available(), "both arenas recycled");
+
+    // Three scopes, the middle one ending first
+    {
+        HTML::MonotonicArena first;
+        HTML::MonotonicArena second;
+        HTML::MonotonicArena third;
+        std::unique_ptr<HTML::ScopedResource> pFirstScope(new HTML::ScopedResource(first));
+        std::unique_ptr<HTML::ScopedResource> pSecondScope(new HTML::ScopedResource(second));
+        std::unique_ptr<HTML::ScopedResource> pThirdScope(new HTML::ScopedResource(third));
+        pSecondScope.reset();
+        failures += check(&HTML::currentResource() == &third, "most recent scope still selected");
+        pThirdScope.reset();
+        failures += check(&HTML::currentResource() == &first, "resource preceding the middle scope restored");
+        pFirstScope.reset();
+        failures += check(&HTML::currentResource() == pGlobal, "global heap restored");
+    }
+
+    // Pages built after them in the global heap, and in another PooledDocument reusing a recycled arena
+    {
+        HTML::PooledDocument page("Again", pool);
+        buildPage(page, "again");
+        failures += check(1 == pool.available(), "recycled arena reused");
+        failures += check(page->toString().find("again") != std::string::npos, "page in a recycled arena");
+    }
+    HTML::Document document("Heap");
+    document << HTML::Paragraph("heap");
+    failures += check(document.toString().find("heap") != std::string::npos, "page in the global heap");
+
+    if (failures > 0) {
+        fprintf(stderr, "%d failed checks\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("DocumentPool: all checks passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file    HashTest.cpp
+ * @ingroup HtmlBuilder
+ * @brief   Reference vectors of the XXH64 content hash, and independence of the digest from the chunks appended.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <HTML/HTML.h>
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+/// Digest of a string appended at once
+static uint64_t digest(const std::string& aString) {
+    HTML::ContentHash hash;
+    hash.append(aString.data(), aString.size());
+    return hash.digest();
+}
+
+/// Report a failed check, returning the number of failures
+static int check(const bool abSuccess, const char* apWhat) {
+    if (!abSuccess) {
+        fprintf(stderr, "FAILED: %s\n", apWhat);
+    }
+    return abSuccess ? 0 : 1;
+}
+
+/// Check a digest against its reference XXH64 value (seed 0)
+static int checkVector(const std::string& aString, const uint64_t aExpected) {
+    const uint64_t value = digest(aString);
+    if (value != aExpected) {
+        fprintf(stderr, "FAILED: XXH64(\"%s\") = %016" PRIX64 " instead of %016" PRIX64 "\n",
+                aString.c_str(), value, aExpected);
+        return 1;
+    }
+    return 0;
+}
+
+/**
+ * @brief Entry-point of the test, returning EXIT_FAILURE on any failed check.
+ */
+int main() {
+    int failures = 0;
+
+    // Reference vectors of XXH64, below and beyond the 32 bytes of a stripe
+    failures += checkVector("", 0xEF46DB3751D8E999ULL);
+    failures += checkVector("abc", 0x44BC2CF5AD770999ULL);
+    failures += checkVector("Nobody inspects the spammish repetition", 0xFBCEA83C8A378BF1ULL);
+
+    // The same digest whatever the size of the chunks appended, across the stripes and the buffered tail
+    std::string content;
+    for (int idx = 0; idx < 1000; ++idx) {
+        content += std::to_string(idx * 7919);
+        content += ',';
+    }
+    const uint64_t expected = digest(content);
+    const size_t steps[] = {1, 3, 7, 8, 31, 32, 33, 100, 4096};
+    for (const size_t step : steps) {
+        HTML::ContentHash hash;
+        for (size_t offset = 0; offset < content.size(); offset += step) {
+            hash.append(content.data() + offset, std::min(step, content.size() - offset));
+        }
+        failures += check((hash.digest() == expected) && (hash.size() == content.size()), "chunked digest");
+    }
+
+    // Repeated characters, like an indentation, hashed as the same characters appended at once
+    HTML::ContentHash indentation;
+    indentation.append(100, ' ');
+    failures += check(indentation.digest() == digest(std::string(100, ' ')), "repeated characters");
+
+    // The serialization of a Document hashed as it is written
+    HTML::Document document("Title");
+    document << (HTML::Div("content") << HTML::Header1("Welcome") << HTML::Fragment(HTML::Span("frozen")));
+    HTML::ContentHash hash;
+    document.appendTo(hash);
+    failures += check(hash.digest() == digest(document.toString()), "document digest");
+
+    if (failures > 0) {
+        fprintf(stderr, "%d failed checks\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("ContentHash: all checks passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file    LayoutTest.cpp
+ * @ingroup HtmlBuilder
+ * @brief   Content of the Renderables indented by the levels of the layout, like the Elements around it.
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <HTML/HTML.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+typedef HTML::PrettyLayout<4> Four;
+typedef HTML::PrettyLayout<4, HTML::Endline::CRLF> FourCrlf;
+typedef HTML::PrettyLayout<3> Three;
+
+/// Report a failed check, returning the number of failures
+static int check(const bool abSuccess, const char* apWhat) {
+    if (!abSuccess) {
+        fprintf(stderr, "FAILED: %s\n", apWhat);
+    }
+    return abSuccess ? 0 : 1;
+}
+
+/// The same HTML for a Renderable content and for the equivalent Elements, in each layout
+static int checkLayouts(const HTML::Element& aContent, const HTML::Element& aElements, const char* apWhat) {
+    int failures = 0;
+    failures += check(aContent.toString() == aElements.toString(), apWhat);
+    failures += check(aContent.toString(HTML::Format::Minified) == aElements.toString(HTML::Format::Minified), apWhat);
+    failures += check(aContent.toString<Four>() == aElements.toString<Four>(), apWhat);
+    failures += check(aContent.toString<FourCrlf>() == aElements.toString<FourCrlf>(), apWhat);
+    failures += check(aContent.toString<Three>() == aElements.toString<Three>(), apWhat);
+    failures += check(aContent.renderedSize<Four>() == aElements.renderedSize<Four>(), apWhat);
+    return failures;
+}
+
+/**
+ * @brief Entry-point of the test, returning EXIT_FAILURE on any failed check.
+ */
+int main() {
+    int failures = 0;
+
+    // Fragment nested in Elements
+    HTML::Div elements("outer");
+    elements << (HTML::Div("inner") << (HTML::Div("frozen") << HTML::Span("text")));
+    HTML::Div fragment("outer");
+    fragment << (HTML::Div("inner") << HTML::Fragment(HTML::Div("frozen") << HTML::Span("text")));
+    failures += checkLayouts(fragment, elements, "Fragment");
+
+    // Rows of a DataTable
+    HTML::DataTable dataTable;
+    dataTable.addColumn("Header", std::vector<std::string>{"value"});
+    HTML::Table table;
+    table << (HTML::Row() << HTML::ColHeader("Header")) << (HTML::Row() << HTML::Col("value"));
+    failures += checkLayouts(HTML::Div("wrap") << std::move(dataTable), HTML::Div("wrap") << std::move(table),
+                             "DataTable");
+
+    // Elements rendered through a Writer, like the default content of a Slot
+    HTML::Div slot("outer");
+    slot << (HTML::Div("inner") << HTML::Slot("name", HTML::Div("default") << HTML::Span("text")));
+    HTML::Div plain("outer");
+    plain << (HTML::Div("inner") << (HTML::Div("default") << HTML::Span("text")));
+    failures += checkLayouts(slot, plain, "Slot");
+
+    // FlatDocument
+    HTML::Document document("Title");
+    document << HTML::Div(fragment);
+    HTML::Document expected("Title");
+    expected << HTML::Div(elements);
+    std::string flat;
+    HTML::FlatDocument(document).appendTo<Four>(flat);
+    failures += check(flat == expected.toString<Four>(), "FlatDocument");
+
+    if (failures > 0) {
+        fprintf(stderr, "%d failed checks\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("Layout: all checks passed\n");
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,166 @@
+/**
+ * @file    SharedTest.cpp
+ * @ingroup HtmlBuilder
+ * @brief   Shared subtree serialized like a copy by every serializer, and concurrently by many threads.
+ *
+ *   Meant to also run under ThreadSanitizer and AddressSanitizer, configuring the build with
+ * -DCMAKE_CXX_FLAGS="-fsanitize=thread" or -DCMAKE_CXX_FLAGS="-fsanitize=address,undefined".
+ *
+ * Copyright (c) 2017-2019 Sebastien Rombauts (sebastien.rombauts@gmail.com)
+ *
+ * Distributed under the MIT License (MIT) (See accompanying file LICENSE.txt
+ * or copy at http://opensource.org/licenses/MIT)
+ */
+
+#include <HTML/HTML.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Report a failed check, returning the number of failures
+static int check(const bool abSuccess, const char* apWhat) {
+    if (!abSuccess) {
+        fprintf(stderr, "FAILED: %s\n", apWhat);
+    }
+    return abSuccess ? 0 : 1;
+}
+
+/// Navigation bar with special characters to escape
+static HTML::Element buildNavigation() {
+    HTML::List list(false, "navbar-nav");
+    for (int idx = 0; idx < 50; ++idx) {
+        list << (HTML::ListItem().cls("nav-item")
+            << HTML::Link("Item " + std::to_string(idx) + " <&>", "#").cls("nav-link"));
+    }
+    return std::move(HTML::Nav("navbar") << std::move(list));
+}
+
+/// The same output for the Shared subtree and for a copy, with every serializer of the layout
+static int checkSerializers(const HTML::Element& aNavigation, const HTML::Shared& aShared, const HTML::Format aFormat) {
+    int failures = 0;
+    HTML::Document copied("Title");
+    HTML::Document shared("Title");
+    copied.body() << (HTML::Div("wrap") << HTML::Element(aNavigation));
+    shared.body() << (HTML::Div("wrap") << HTML::Shared(aShared));
+
+    const std::string html = copied.toString(aFormat);
+    failures += check(shared.toString(aFormat) == html, "toString()");
+    failures += check(shared.renderedSize(aFormat) == copied.renderedSize(aFormat), "renderedSize()");
+    failures += check(shared.toString(HTML::ParallelPolicy(4)) == copied.toString(HTML::ParallelPolicy(4)),
+                      "parallel toString()");
+
+    HTML::ContentHash copiedHash;
+    HTML::ContentHash sharedHash;
+    copied.appendTo<HTML::Pretty>(copiedHash);
+    shared.appendTo<HTML::Pretty>(sharedHash);
+    failures += check(sharedHash.digest() == copiedHash.digest(), "ContentHash");
+
+    std::string copiedFlat;
+    std::string sharedFlat;
+    HTML::FlatDocument(copied).appendTo(copiedFlat);
+    HTML::FlatDocument(shared).appendTo(sharedFlat);
+    failures += check(sharedFlat == copiedFlat, "FlatDocument");
+    failures += check(HTML::Fragment(shared).html() == HTML::Fragment(copied).html(), "Fragment");
+
+    std::string copiedStream;
+    std::string sharedStream;
+    HTML::StringSink copiedSink(copiedStream);
+    HTML::StringSink sharedSink(sharedStream);
+    HTML::StreamWriter copiedWriter(copiedSink, copied);
+    copiedWriter.finish();
+    HTML::StreamWriter sharedWriter(sharedSink, shared);
+    sharedWriter.finish();
+    failures += check(sharedStream == copiedStream, "StreamWriter");
+
+    std::string copiedChunks;
+    std::string sharedChunks;
+    HTML::ChunkedWriter copiedChunked(copied, [&copiedChunks](const char* apData, size_t aSize) {
+        copiedChunks.append(apData, aSize);
+        return true;
+    }, 64);
+    while (!copiedChunked.resume()) {}
+    HTML::ChunkedWriter sharedChunked(shared, [&sharedChunks](const char* apData, size_t aSize) {
+        sharedChunks.append(apData, aSize);
+        return true;
+    }, 64);
+    while (!sharedChunked.resume()) {}
+    failures += check(sharedChunks == copiedChunks, "ChunkedWriter");
+    return failures;
+}
+
+/**
+ * @brief Entry-point of the test, returning EXIT_FAILURE on any failed check.
+ */
+int main() {
+    int failures = 0;
+    HTML::Element navigation = buildNavigation();
+    const HTML::Shared shared(navigation);
+
+    failures += checkSerializers(navigation, shared, HTML::Format::Pretty);
+    failures += checkSerializers(navigation, shared, HTML::Format::Minified);
+
+    // Modifying the original Element does not change the shared copy
+    navigation << HTML::Paragraph("later");
+    failures += check(shared.element().toString().find("later") == std::string::npos, "immutable copy");
+
+    // A Shared inserted in the arena of a PooledDocument is not copied, and outlives the arena
+    HTML::Element kept("");
+    {
+        HTML::PooledDocument page("Pooled");
+        HTML::CountingResource counter;
+        HTML::ScopedResource scope(counter);
+        page->body() << HTML::Shared(shared);
+        failures += check(0 == counter.blocks(), "no copy in the arena");
+        kept = HTML::Shared(shared);
+    }
+    failures += check(kept.toString() == shared.element().toString(), "Shared outliving the arena");
+
+    // A Shared inserted where only some Element types are accepted, like a copy of the same Element
+    const HTML::Shared stylesheet(HTML::Rel("stylesheet", "style.css"));
+    HTML::Head copiedHead;
+    copiedHead << HTML::Rel("stylesheet", "style.css");
+    failures += check((HTML::Head() << HTML::Shared(stylesheet)).toString() == copiedHead.toString(),
+                      "Shared in a Head");
+    const HTML::Shared header(HTML::Row() << HTML::ColHeader("Name") << HTML::ColHeader("Value"));
+    HTML::Table copiedTable;
+    copiedTable << (HTML::Row() << HTML::ColHeader("Name") << HTML::ColHeader("Value"));
+    failures += check((HTML::Table() << HTML::Shared(header)).toString() == copiedTable.toString(),
+                      "Shared in a Table");
+    const HTML::Shared item(HTML::ListItem("Item"));
+    HTML::List copiedList;
+    copiedList << HTML::ListItem("Item");
+    failures += check((HTML::List() << HTML::Shared(item)).toString() == copiedList.toString(), "Shared in a List");
+
+    // Concurrent serialization of the same subtree by many threads, each one in its own PooledDocument
+    HTML::Document reference("Title");
+    reference << HTML::Shared(shared) << HTML::Paragraph("Request");
+    const std::string expected = reference.toString();
+    std::atomic<int> errors(0);
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 8; ++thread) {
+        threads.emplace_back([&shared, &expected, &errors] {
+            for (int page = 0; page < 200; ++page) {
+                HTML::PooledDocument document("Title");
+                *document << HTML::Shared(shared) << HTML::Paragraph("Request");
+                if ((document->toString() != expected) || (0 == shared.element().renderedSize())) {
+                    ++errors;
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    failures += check(0 == errors, "concurrent serialization");
+
+    if (failures > 0) {
+        fprintf(stderr, "%d failed checks\n", failures);
+        return EXIT_FAILURE;
+    }
+    printf("Shared: all checks passed\n");
+    return EXIT_SUCCESS;
+}